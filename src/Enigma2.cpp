@@ -8,8 +8,10 @@
 #include "Enigma2.h"
 
 #include "enigma2/TimeshiftBuffer.h"
+#include "enigma2/TimeshiftMemoryBuffer.h"
 #include "enigma2/utilities/CurlFile.h"
 #include "enigma2/utilities/Logger.h"
+#include "enigma2/utilities/RequestScheduler.h"
 #include "enigma2/utilities/StreamUtils.h"
 #include "enigma2/utilities/WebUtils.h"
 #include "enigma2/utilities/XMLUtils.h"
@@ -85,7 +87,7 @@ PVR_ERROR Enigma2::GetCapabilities(kodi::addon::PVRCapabilities& capabilities)
   capabilities.SetSupportsRecordingsRename(m_settings->SupportsEditingRecordings());
   capabilities.SetSupportsRecordingsLifetimeChange(false);
   capabilities.SetSupportsDescrambleInfo(false);
-  capabilities.SetSupportsAsyncEPGTransfer(false);
+  capabilities.SetSupportsAsyncEPGTransfer(m_settings->GetEPGAsyncTransfer());
   capabilities.SetSupportsRecordingSize(m_settings->SupportsRecordingSizes());
   capabilities.SetSupportsProviders(true);
 
@@ -129,6 +131,9 @@ void Enigma2::ConnectionLost()
   if (m_thread.joinable())
     m_thread.join();
 
+  Logger::Log(LEVEL_DEBUG, "%s Stopping EPG harvester...", __func__);
+  m_epgHarvester.Stop();
+
   std::lock_guard<std::mutex> lock(m_mutex);
   m_currentChannel = -1;
   m_isConnected = false;
@@ -136,6 +141,9 @@ void Enigma2::ConnectionLost()
 
 void Enigma2::ConnectionEstablished()
 {
+  // Loading channels, timers and EPG on (re)connect must not hold up playback
+  RequestPriorityScope priorityScope(RequestPriority::BACKGROUND);
+
   std::lock_guard<std::mutex> lock(m_mutex);
 
   Logger::Log(LEVEL_DEBUG, "%s Removing internal channels and groups lists...", __func__);
@@ -188,8 +196,13 @@ void Enigma2::ConnectionEstablished()
 
   m_epg.Initialise(m_channels, m_channelGroups);
 
+  // The channels the timers refer to may have changed so parse the timer lists again
+  m_timers.ClearCachedResponses();
   m_timers.TimerUpdates();
 
+  if (m_settings->GetEPGAsyncTransfer())
+    m_epgHarvester.Start();
+
   Logger::Log(LEVEL_INFO, "%s Starting separate client update thread...", __func__);
   m_running = true;
   m_thread = std::thread([&] { Process(); });
@@ -234,6 +247,9 @@ void Enigma2::Process()
 {
   Logger::Log(LEVEL_DEBUG, "%s - starting", __func__);
 
+  // Timer, recording and channel updates are all background sync
+  RequestPriorityScope priorityScope(RequestPriority::BACKGROUND);
+
   unsigned int updateTimer = 0;
   time_t lastUpdateTimeSeconds = std::time(nullptr);
   int lastUpdateHour = m_settings->GetChannelAndGroupUpdateHour(); //ignore if we start during same hour
@@ -345,6 +361,8 @@ ChannelsChangeState Enigma2::CheckForChannelAndGroupChanges()
 
 void Enigma2::ReloadChannelsGroupsAndEPG()
 {
+  m_epgHarvester.Stop();
+
   Logger::Log(LEVEL_DEBUG, "%s Removing internal channels list...", __func__);
   m_channels.ClearChannels();
   m_channelGroups.ClearChannelGroups();
@@ -362,10 +380,19 @@ void Enigma2::ReloadChannelsGroupsAndEPG()
 
   m_epg.Initialise(m_channels, m_channelGroups);
 
+  // The channels the timers refer to may have changed so parse the timer lists again
+  m_timers.ClearCachedResponses();
   m_timers.TimerUpdates();
 
-  for (const auto& myChannel : m_channels.GetChannelsList())
-    kodi::addon::CInstancePVRClient::TriggerEpgUpdate(myChannel->GetUniqueId());
+  if (m_settings->GetEPGAsyncTransfer())
+  {
+    m_epgHarvester.Start();
+  }
+  else
+  {
+    for (const auto& myChannel : m_channels.GetChannelsList())
+      kodi::addon::CInstancePVRClient::TriggerEpgUpdate(myChannel->GetUniqueId());
+  }
 
   kodi::addon::CInstancePVRClient::TriggerRecordingUpdate();
 }
@@ -503,6 +530,8 @@ PVR_ERROR Enigma2::GetChannelStreamProperties(const kodi::addon::PVRChannel& cha
   if (!IsConnected())
     return PVR_ERROR_SERVER_ERROR;
 
+  RequestPriorityScope priorityScope(RequestPriority::PLAYBACK);
+
   //
   // For Enimga2 native streams we only set properties that do not change the stream URL as they use
   // their own inputstream within the add-on. First we set the MIME type as it will always be "video/mp2t" and
@@ -560,9 +589,6 @@ PVR_ERROR Enigma2::GetChannelStreamProperties(const kodi::addon::PVRChannel& cha
 
 PVR_ERROR Enigma2::GetEPGForChannel(int channelUid, time_t start, time_t end, kodi::addon::PVREPGTagsResultSet& results)
 {
-  if (m_settings->GetEPGDelayPerChannelDelay() != 0)
-    std::this_thread::sleep_for(std::chrono::seconds(m_settings->GetEPGDelayPerChannelDelay()));
-
   //Have a lock while getting the channel. Then we don't have to worry about a disconnection while retrieving the EPG data.
   std::shared_ptr<Channel> myChannel;
   {
@@ -577,6 +603,9 @@ PVR_ERROR Enigma2::GetEPGForChannel(int channelUid, time_t start, time_t end, ko
     myChannel = m_channels.GetChannel(channelUid);
   }
 
+  // Kodi sweeps the EPG of every channel, that must not hold up playback
+  RequestPriorityScope priorityScope(RequestPriority::BACKGROUND);
+
   return m_epg.GetEPGForChannel(myChannel->GetServiceReference(), start, end, results);
 }
 
@@ -610,6 +639,8 @@ bool Enigma2::OpenLiveStream(const kodi::addon::PVRChannel& channelinfo)
   Logger::Log(LEVEL_DEBUG, "%s: channel=%u", __func__, channelinfo.GetUniqueId());
   std::lock_guard<std::mutex> lock(m_mutex);
 
+  RequestPriorityScope priorityScope(RequestPriority::PLAYBACK);
+
   if (channelinfo.GetUniqueId() != m_currentChannel)
   {
     m_currentChannel = channelinfo.GetUniqueId();
@@ -629,15 +660,15 @@ bool Enigma2::OpenLiveStream(const kodi::addon::PVRChannel& channelinfo)
   }
 
   /* queue a warning if the timeshift buffer path does not exist */
-  if (m_settings->GetTimeshift() != Timeshift::OFF && !m_settings->IsTimeshiftBufferPathValid())
+  if (m_settings->GetTimeshift() != Timeshift::OFF && !m_settings->IsTimeshiftBufferAvailable())
     kodi::QueueNotification(QUEUE_ERROR, "", kodi::addon::GetLocalizedString(30514));
 
   const std::string streamURL = GetLiveStreamURL(channelinfo);
   m_activeStreamReader = new StreamReader(streamURL, m_settings->GetReadTimeoutSecs());
-  if (m_settings->GetTimeshift() == Timeshift::ON_PLAYBACK && m_settings->IsTimeshiftBufferPathValid())
+  if (m_settings->GetTimeshift() == Timeshift::ON_PLAYBACK && m_settings->IsTimeshiftBufferAvailable())
   {
     m_timeshiftInternalStreamReader = m_activeStreamReader;
-    m_activeStreamReader = new TimeshiftBuffer(m_activeStreamReader, m_settings);
+    m_activeStreamReader = CreateTimeshiftBuffer(m_activeStreamReader);
   }
 
   return m_activeStreamReader->Start();
@@ -652,6 +683,14 @@ void Enigma2::CloseLiveStream()
     SafeDelete(m_timeshiftInternalStreamReader);
 }
 
+IStreamReader* Enigma2::CreateTimeshiftBuffer(IStreamReader* streamReader)
+{
+  if (m_settings->GetTimeshiftBufferType() == TimeshiftBufferType::MEMORY)
+    return new TimeshiftMemoryBuffer(streamReader, m_settings);
+
+  return new TimeshiftBuffer(streamReader, m_settings);
+}
+
 const std::string Enigma2::GetLiveStreamURL(const kodi::addon::PVRChannel& channelinfo)
 {
   if (m_settings->GetAutoConfigLiveStreamsEnabled())
@@ -793,7 +832,8 @@ bool Enigma2::OpenRecordedStream(const kodi::addon::PVRRecording& recinfo, int64
     end = timer->GetRealEndTime();
   }
 
-  m_recordingReader = new RecordingReader(m_recordings.GetRecordingURL(recinfo), start, end, recinfo.GetDuration());
+  m_recordingReader = new RecordingReader(m_recordings.GetRecordingURL(recinfo), start, end, recinfo.GetDuration(),
+                                          m_settings->GetRecordingReadAheadBytes());
   return m_recordingReader->Start();
 }
 
@@ -1033,7 +1073,7 @@ bool Enigma2::CanPauseStream()
   if (!IsConnected())
     return false;
 
-  if (m_settings->GetTimeshift() != Timeshift::OFF && m_activeStreamReader && m_settings->IsTimeshiftBufferPathValid())
+  if (m_settings->GetTimeshift() != Timeshift::OFF && m_activeStreamReader && m_settings->IsTimeshiftBufferAvailable())
     return (m_settings->GetTimeshift() == Timeshift::ON_PAUSE || m_paused || m_activeStreamReader->HasTimeshiftCapacity());
 
   return false;
@@ -1070,7 +1110,7 @@ PVR_ERROR Enigma2::GetStreamTimes(kodi::addon::PVRStreamTimes& times)
     times.SetPTSStart(0);
     times.SetPTSBegin(0);
     times.SetPTSEnd((!m_activeStreamReader->IsTimeshifting()) ? 0
-      : (m_activeStreamReader->TimeEnd() - m_activeStreamReader->TimeStart()) * STREAM_TIME_BASE);
+      : m_activeStreamReader->DurationMs() * STREAM_TIME_BASE / 1000);
 
     if (m_activeStreamReader->IsTimeshifting())
     {
@@ -1107,10 +1147,10 @@ void Enigma2::PauseStream(bool paused)
   /* start timeshift on pause */
   if (paused && m_settings->GetTimeshift() == Timeshift::ON_PAUSE &&
       m_activeStreamReader && !m_activeStreamReader->IsTimeshifting() &&
-      m_settings->IsTimeshiftBufferPathValid())
+      m_settings->IsTimeshiftBufferAvailable())
   {
     m_timeshiftInternalStreamReader = m_activeStreamReader;
-    m_activeStreamReader = new TimeshiftBuffer(m_activeStreamReader, m_settings);
+    m_activeStreamReader = CreateTimeshiftBuffer(m_activeStreamReader);
     m_activeStreamReader->Start();
   }
 
@@ -13,6 +13,7 @@
 #include "enigma2/Channels.h"
 #include "enigma2/ConnectionManager.h"
 #include "enigma2/Epg.h"
+#include "enigma2/EpgHarvester.h"
 #include "enigma2/IConnectionListener.h"
 #include "enigma2/InstanceSettings.h"
 #include "enigma2/RecordingReader.h"
@@ -141,6 +142,7 @@ private:
   std::string GetStreamURL(const std::string& strM3uURL);
   enigma2::ChannelsChangeState CheckForChannelAndGroupChanges();
   void ReloadChannelsGroupsAndEPG();
+  enigma2::IStreamReader* CreateTimeshiftBuffer(enigma2::IStreamReader* streamReader);
 
   // members
   bool m_isConnected = false;
@@ -157,6 +159,7 @@ private:
   enigma2::Recordings m_recordings{*this, m_settings, m_channels, m_providers, m_entryExtractor};
   std::vector<std::string>& m_locations = m_recordings.GetLocations();
   enigma2::Epg m_epg{*this, m_channels, m_entryExtractor, m_settings, m_epgMaxPastDays, m_epgMaxFutureDays};
+  enigma2::EpgHarvester m_epgHarvester{*this, m_epg, m_channels, m_settings};
   enigma2::Timers m_timers{*this, m_settings, m_channels, m_channelGroups, m_locations, m_epg, m_entryExtractor};
   enigma2::Admin m_admin{m_settings};
   enigma2::extract::EpgEntryExtractor m_entryExtractor{m_settings};
@@ -13,6 +13,12 @@ using namespace enigma2;
 using namespace enigma2::data;
 using namespace enigma2::utilities;
 
+CEnigma2Addon::~CEnigma2Addon()
+{
+  /* The logger implementation refers to this addon, write out anything still queued */
+  Logger::GetInstance().SetAsync(false);
+}
+
 ADDON_STATUS CEnigma2Addon::Create()
 {
   /* Init settings */
@@ -23,10 +29,6 @@ ADDON_STATUS CEnigma2Addon::Create()
   /* Configure the logger */
   Logger::GetInstance().SetImplementation([this](LogLevel level, const char* message)
   {
-    /* Don't log trace messages unless told so */
-    if (level == LogLevel::LEVEL_TRACE && !m_settings->GetTraceDebug())
-      return;
-
     /* Convert the log level */
     ADDON_LOG addonLevel;
 
@@ -48,9 +50,6 @@ ADDON_STATUS CEnigma2Addon::Create()
         addonLevel = ADDON_LOG::ADDON_LOG_DEBUG;
     }
 
-    if (addonLevel == ADDON_LOG::ADDON_LOG_DEBUG && m_settings->GetNoDebug())
-      return;
-
     if (addonLevel == ADDON_LOG::ADDON_LOG_DEBUG && m_settings->GetDebugNormal())
       addonLevel = ADDON_LOG::ADDON_LOG_INFO;
 
@@ -59,6 +58,8 @@ ADDON_STATUS CEnigma2Addon::Create()
 
   Logger::GetInstance().SetPrefix("pvr.vuplus");
 
+  ConfigureLogger();
+
   Logger::Log(LogLevel::LEVEL_INFO, "%s starting PVR client...", __func__);
 
   return ADDON_STATUS_OK;
@@ -66,7 +67,20 @@ ADDON_STATUS CEnigma2Addon::Create()
 
 ADDON_STATUS CEnigma2Addon::SetSetting(const std::string& settingName, const kodi::addon::CSettingValue& settingValue)
 {
-  return m_settings->SetSetting(settingName, settingValue);
+  const ADDON_STATUS status = m_settings->SetSetting(settingName, settingValue);
+
+  ConfigureLogger();
+
+  return status;
+}
+
+void CEnigma2Addon::ConfigureLogger()
+{
+  /* Disabled levels are dropped before the message is even formatted */
+  Logger::GetInstance().SetLevelEnabled(LogLevel::LEVEL_TRACE, m_settings->GetTraceDebug() && !m_settings->GetNoDebug());
+  Logger::GetInstance().SetLevelEnabled(LogLevel::LEVEL_DEBUG, !m_settings->GetNoDebug());
+
+  Logger::GetInstance().SetAsync(m_settings->GetAsyncLogging());
 }
 
 ADDON_STATUS CEnigma2Addon::CreateInstance(const kodi::addon::IInstanceInfo& instance, KODI_ADDON_INSTANCE_HDL& hdl)
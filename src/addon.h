@@ -20,6 +20,7 @@ class ATTR_DLL_LOCAL CEnigma2Addon : public kodi::addon::CAddonBase
 {
 public:
   CEnigma2Addon() = default;
+  ~CEnigma2Addon() override;
 
   ADDON_STATUS Create() override;
   ADDON_STATUS SetSetting(const std::string& settingName, const kodi::addon::CSettingValue& settingValue) override;
@@ -27,6 +28,8 @@ public:
   void DestroyInstance(const kodi::addon::IInstanceInfo& instance, const KODI_ADDON_INSTANCE_HDL hdl) override;
 
 private:
+  void ConfigureLogger();
+
   std::unordered_map<std::string, Enigma2*> m_usedInstances;
   std::shared_ptr<enigma2::AddonSettings> m_settings;
 };
@@ -52,6 +52,7 @@ void AddonSettings::ReadSettings()
   m_noDebug = kodi::addon::GetSettingBoolean("nodebug", false);
   m_debugNormal = kodi::addon::GetSettingBoolean("debugnormal", false);
   m_traceDebug = kodi::addon::GetSettingBoolean("tracedebug", false);
+  m_asyncLogging = kodi::addon::GetSettingBoolean("asynclogging", false);
 }
 
 ADDON_STATUS AddonSettings::SetSetting(const std::string& settingName,
@@ -63,6 +64,8 @@ ADDON_STATUS AddonSettings::SetSetting(const std::string& settingName,
     return SetSetting<bool, ADDON_STATUS>(settingName, settingValue, m_debugNormal, ADDON_STATUS_OK, ADDON_STATUS_OK);
   else if (settingName == "tracedebug")
     return SetSetting<bool, ADDON_STATUS>(settingName, settingValue, m_traceDebug, ADDON_STATUS_OK, ADDON_STATUS_OK);
+  else if (settingName == "asynclogging")
+    return SetSetting<bool, ADDON_STATUS>(settingName, settingValue, m_asyncLogging, ADDON_STATUS_OK, ADDON_STATUS_OK);
   else if (SettingsMigration::IsMigrationSetting(settingName))
   {
     // ignore settings from pre-multi-instance setup
@@ -37,6 +37,7 @@ class AddonSettings
     bool GetNoDebug() const { return m_noDebug; };
     bool GetDebugNormal() const { return m_debugNormal; };
     bool GetTraceDebug() const { return m_traceDebug; };
+    bool GetAsyncLogging() const { return m_asyncLogging; };
 
   private:
     AddonSettings(const AddonSettings&) = delete;
@@ -105,6 +106,7 @@ class AddonSettings
     bool m_noDebug = false;
     bool m_debugNormal = false;
     bool m_traceDebug = false;
+    bool m_asyncLogging = false;
 };
 
 } // namespace enigma2
\ No newline at end of file
@@ -98,7 +98,7 @@ bool Admin::LoadDeviceInfo()
 {
   const std::string url = StringUtils::Format("%s%s", m_settings->GetConnectionURL().c_str(), "web/deviceinfo");
 
-  const std::string strXML = WebUtils::GetHttpXML(url);
+  const std::string strXML = WebUtils::GetHttpXMLShared(url, DEVICE_INFO_SHARED_TTL_MS);
 
   TiXmlDocument xmlDoc;
   if (!xmlDoc.Parse(strXML.c_str()))
@@ -490,7 +490,26 @@ PVR_ERROR Admin::GetDriveSpace(uint64_t& iTotal, uint64_t& iUsed, std::vector<st
 
   const std::string url = StringUtils::Format("%s%s", m_settings->GetConnectionURL().c_str(), "web/deviceinfo");
 
-  const std::string strXML = WebUtils::GetHttpXML(url);
+  // Only a successful result is remembered so any error is retried
+  const CachedResponse cachedResponse = m_deviceInfoResponse;
+  m_deviceInfoResponse.Clear();
+  if (locations == m_driveSpaceLocations)
+    m_deviceInfoResponse = cachedResponse;
+
+  std::string strXML;
+  bool unchanged = false;
+  if (WebUtils::GetHttpXMLSharedIfChanged(url, DEVICE_INFO_SHARED_TTL_MS, m_deviceInfoResponse, strXML, unchanged) && unchanged)
+  {
+    iTotal = m_driveSpaceTotalKb;
+    iUsed = m_driveSpaceUsedKb;
+
+    Logger::Log(LEVEL_DEBUG, "%s Space unchanged, Total: %lld, Used %lld", __func__, iTotal, iUsed);
+
+    return PVR_ERROR_NO_ERROR;
+  }
+
+  const CachedResponse newResponse = m_deviceInfoResponse;
+  m_deviceInfoResponse.Clear();
 
   TiXmlDocument xmlDoc;
   if (!xmlDoc.Parse(strXML.c_str()))
@@ -554,6 +573,11 @@ PVR_ERROR Admin::GetDriveSpace(uint64_t& iTotal, uint64_t& iUsed, std::vector<st
   iTotal = totalKb;
   iUsed = totalKb - freeKb;
 
+  m_deviceInfoResponse = newResponse;
+  m_driveSpaceLocations = locations;
+  m_driveSpaceTotalKb = iTotal;
+  m_driveSpaceUsedKb = iUsed;
+
   Logger::Log(LEVEL_DEBUG, "%s Space Total: %lld, Used %lld", __func__, iTotal, iUsed);
 
   return PVR_ERROR_NO_ERROR;
@@ -13,6 +13,7 @@
 #include "utilities/SignalStatus.h"
 #include "utilities/StreamStatus.h"
 #include "utilities/Tuner.h"
+#include "utilities/WebUtils.h"
 
 #include <string>
 #include <vector>
@@ -58,6 +59,9 @@ namespace enigma2
     utilities::StreamStatus GetStreamDetails(const std::shared_ptr<data::Channel>& channel);
     void GetTunerDetails(utilities::SignalStatus& signalStatus, const std::shared_ptr<data::Channel>& channel);
 
+    // web/deviceinfo is loaded on connect and right after for the drive space, a result this recent is good enough
+    static const int DEVICE_INFO_SHARED_TTL_MS = 1000;
+
     char m_serverName[256];
     char m_serverVersion[256];
     bool m_deviceHasHDD = true;
@@ -66,6 +70,12 @@ namespace enigma2
     enigma2::utilities::DeviceSettings m_deviceSettings;
     std::vector<enigma2::utilities::Tuner> m_tuners;
 
+    // the drive space only needs to be worked out again when the device info changes
+    enigma2::utilities::CachedResponse m_deviceInfoResponse;
+    std::vector<std::string> m_driveSpaceLocations;
+    uint64_t m_driveSpaceTotalKb = 0;
+    uint64_t m_driveSpaceUsedKb = 0;
+
     std::shared_ptr<enigma2::InstanceSettings> m_settings;
   };
 } //namespace enigma2
@@ -12,7 +12,8 @@
 #include "ChannelGroups.h"
 #include "utilities/Logger.h"
 #include "utilities/WebUtils.h"
-#include "utilities/XMLUtils.h"
+#include "utilities/XmlFields.h"
+#include "utilities/XmlStreamReader.h"
 
 #include <regex>
 
@@ -225,49 +226,43 @@ bool Channels::LoadChannels(const std::string groupServiceReference, const std::
 
   const std::string strTmp = StringUtils::Format("%sweb/getservices?sRef=%s", m_settings->GetConnectionURL().c_str(), WebUtils::URLEncodeInline(groupServiceReference).c_str());
 
-  const std::string strXML = WebUtils::GetHttpXML(strTmp);
+  bool emptyGroup = true;
 
-  TiXmlDocument xmlDoc;
-  if (!xmlDoc.Parse(strXML.c_str()))
-  {
-    Logger::Log(LEVEL_ERROR, "%s Unable to parse XML: %s at line %d", __func__, xmlDoc.ErrorDesc(), xmlDoc.ErrorRow());
-    return false;
-  }
+  XmlFields channelFields(Channel::GetXmlFieldTable());
 
-  TiXmlHandle hDoc(&xmlDoc);
+  XmlStreamReader xmlReader("e2servicelist", "e2service", [&](std::string_view element) {
+    channelFields.Read(element);
 
-  TiXmlElement* pElem = hDoc.FirstChildElement("e2servicelist").Element();
+    Channel newChannel{m_settings};
+    newChannel.SetRadio(channelGroup->IsRadio());
 
-  if (!pElem)
-  {
-    Logger::Log(LEVEL_ERROR, "%s Could not find <e2servicelist> element!", __func__);
-    return false;
-  }
+    if (!newChannel.UpdateFrom(channelFields))
+      return true;
+    else
+      emptyGroup = false;
 
-  TiXmlHandle hRoot = TiXmlHandle(pElem);
+    AddChannel(newChannel, channelGroup);
+    Logger::Log(LEVEL_DEBUG, "%s Loaded channel: %s, Group: %s, Icon: %s, ID: %d", "LoadChannels", newChannel.GetChannelName().c_str(), groupName.c_str(), newChannel.GetIconPath().c_str(), newChannel.GetUniqueId());
 
-  TiXmlElement* pNode = hRoot.FirstChildElement("e2service").Element();
+    return true;
+  });
 
-  if (!pNode)
+  if (!WebUtils::GetHttpStream(strTmp, [&](const char* data, size_t size) { return xmlReader.AddData(data, size); }))
   {
-    Logger::Log(LEVEL_ERROR, "%s Could not find <e2service> element", __func__);
+    Logger::Log(LEVEL_ERROR, "%s Unable to load channel group: '%s'", __func__, groupName.c_str());
     return false;
   }
 
-  bool emptyGroup = true;
-
-  for (; pNode != nullptr; pNode = pNode->NextSiblingElement("e2service"))
+  if (!xmlReader.FoundListElement())
   {
-    Channel newChannel{m_settings};
-    newChannel.SetRadio(channelGroup->IsRadio());
-
-    if (!newChannel.UpdateFrom(pNode))
-      continue;
-    else
-      emptyGroup = false;
+    Logger::Log(LEVEL_ERROR, "%s Could not find <e2servicelist> element!", __func__);
+    return false;
+  }
 
-    AddChannel(newChannel, channelGroup);
-    Logger::Log(LEVEL_DEBUG, "%s Loaded channel: %s, Group: %s, Icon: %s, ID: %d", __func__, newChannel.GetChannelName().c_str(), groupName.c_str(), newChannel.GetIconPath().c_str(), newChannel.GetUniqueId());
+  if (xmlReader.GetElementCount() == 0)
+  {
+    Logger::Log(LEVEL_ERROR, "%s Could not find <e2service> element", __func__);
+    return false;
   }
 
   channelGroup->SetEmptyGroup(emptyGroup);
@@ -10,8 +10,10 @@
 #include "../Enigma2.h"
 #include "utilities/Logger.h"
 #include "utilities/WebUtils.h"
-#include "utilities/XMLUtils.h"
+#include "utilities/XmlFields.h"
+#include "utilities/XmlStreamReader.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <regex>
@@ -31,9 +33,11 @@ Epg::Epg(IConnectionListener& connectionListener, enigma2::Channels& channels, e
         m_epgMaxFutureDays(epgMaxFutureDays)
 {
   m_channelsMap = channels.GetChannelsServiceReferenceMap();
+  m_epgCache = std::make_shared<EpgCache>(m_settings);
+  m_rateLimiter = std::make_shared<RateLimiter>();
 }
 
-Epg::Epg(const Epg& epg) : m_connectionListener(epg.m_connectionListener), m_channels(epg.m_channels), m_entryExtractor(epg.m_entryExtractor), m_settings(epg.m_settings) {}
+Epg::Epg(const Epg& epg) : m_connectionListener(epg.m_connectionListener), m_entryExtractor(epg.m_entryExtractor), m_channels(epg.m_channels), m_epgCache(epg.m_epgCache), m_rateLimiter(epg.m_rateLimiter), m_settings(epg.m_settings) {}
 
 bool Epg::Initialise(enigma2::Channels& channels, enigma2::ChannelGroups& channelGroups)
 {
@@ -51,49 +55,19 @@ PVR_ERROR Epg::GetEPGForChannel(const std::string& serviceReference, time_t star
   {
     Logger::Log(LEVEL_DEBUG, "%s Getting EPG for channel '%s'", __func__, channel->GetChannelName().c_str());
 
-    const std::string url = StringUtils::Format("%s%s%s", m_settings->GetConnectionURL().c_str(),
-                                                "web/epgservice?sRef=", WebUtils::URLEncodeInline(serviceReference).c_str());
+    std::vector<EpgEntry> entries;
 
-    const std::string strXML = WebUtils::GetHttpXML(url);
-
-    int iNumEPG = 0;
-
-    TiXmlDocument xmlDoc;
-    if (!xmlDoc.Parse(strXML.c_str()))
+    if (!TakeHarvestedEntries(channel, start, end, entries))
     {
-      Logger::Log(LEVEL_ERROR, "%s Unable to parse XML: %s at line %d", __func__, xmlDoc.ErrorDesc(), xmlDoc.ErrorRow());
-      return PVR_ERROR_SERVER_ERROR;
+      PVR_ERROR error = LoadEntries(channel, start, end, entries);
+      if (error != PVR_ERROR_NO_ERROR)
+        return error;
     }
 
-    TiXmlHandle hDoc(&xmlDoc);
-
-    TiXmlElement* pElem = hDoc.FirstChildElement("e2eventlist").Element();
-
-    if (!pElem)
-    {
-      Logger::Log(LEVEL_WARNING, "%s could not find <e2eventlist> element for channel: %s", __func__, channel->GetChannelName().c_str());
-      // Return "NO_ERROR" as the EPG could be empty for this channel
-      return PVR_ERROR_NO_ERROR;
-    }
-
-    TiXmlHandle hRoot = TiXmlHandle(pElem);
-
-    TiXmlElement* pNode = hRoot.FirstChildElement("e2event").Element();
-
-    if (!pNode)
-    {
-      Logger::Log(LEVEL_WARNING, "%s Could not find <e2event> element for channel: %s", __func__, channel->GetChannelName().c_str());
-      // RETURN "NO_ERROR" as the EPG could be empty for this channel
-      return PVR_ERROR_NO_ERROR;
-    }
+    int iNumEPG = 0;
 
-    for (; pNode != nullptr; pNode = pNode->NextSiblingElement("e2event"))
+    for (auto& entry : entries)
     {
-      EpgEntry entry{m_settings};
-
-      if (!entry.UpdateFrom(pNode, channel, start, end))
-        continue;
-
       if (m_entryExtractor.IsEnabled())
         m_entryExtractor.ExtractFromEntry(entry);
 
@@ -105,7 +79,7 @@ PVR_ERROR Epg::GetEPGForChannel(const std::string& serviceReference, time_t star
 
       iNumEPG++;
 
-      Logger::Log(LEVEL_TRACE, "%s loaded EPG entry '%d:%s' channel '%d' start '%d' end '%d'", __func__, broadcast.GetUniqueBroadcastId(), broadcast.GetTitle().c_str(), entry.GetChannelId(), entry.GetStartTime(), entry.GetEndTime());
+      VUPLUS_LOG(LEVEL_TRACE, "%s loaded EPG entry '%d:%s' channel '%d' start '%d' end '%d'", __func__, broadcast.GetUniqueBroadcastId(), broadcast.GetTitle().c_str(), entry.GetChannelId(), entry.GetStartTime(), entry.GetEndTime());
     }
 
     iNumEPG += TransferTimerBasedEntries(results, channel->GetUniqueId());
@@ -120,6 +94,231 @@ PVR_ERROR Epg::GetEPGForChannel(const std::string& serviceReference, time_t star
   return PVR_ERROR_NO_ERROR;
 }
 
+bool Epg::HarvestEPGForChannel(const std::shared_ptr<data::Channel>& channel, time_t start, time_t end)
+{
+  std::vector<EpgEntry> entries;
+
+  if (LoadEntries(channel, start, end, entries) != PVR_ERROR_NO_ERROR)
+    return false;
+
+  std::lock_guard<std::mutex> lock(m_harvestedMutex);
+  m_harvestedEntries[channel->GetServiceReference()] = std::move(entries);
+
+  return true;
+}
+
+void Epg::ClearHarvestedEntries()
+{
+  std::lock_guard<std::mutex> lock(m_harvestedMutex);
+  m_harvestedEntries.clear();
+}
+
+void Epg::GetEPGTimeWindow(time_t& start, time_t& end) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const time_t now = std::time(nullptr);
+  start = now - m_epgMaxPastDaysSeconds;
+  end = now + m_epgMaxFutureDaysSeconds;
+}
+
+bool Epg::TakeHarvestedEntries(const std::shared_ptr<data::Channel>& channel, time_t start, time_t end, std::vector<data::EpgEntry>& entries)
+{
+  std::lock_guard<std::mutex> lock(m_harvestedMutex);
+
+  auto harvestedEntriesIt = m_harvestedEntries.find(channel->GetServiceReference());
+  if (harvestedEntriesIt == m_harvestedEntries.end())
+    return false;
+
+  for (auto& entry : harvestedEntriesIt->second)
+  {
+    // The window kodi asks for can differ slightly from the one used when harvesting
+    if (start > entry.GetStartTime() || (end > 1 && end < entry.GetEndTime()))
+      continue;
+
+    entries.emplace_back(std::move(entry));
+  }
+
+  m_harvestedEntries.erase(harvestedEntriesIt);
+
+  return true;
+}
+
+PVR_ERROR Epg::LoadEntries(const std::shared_ptr<data::Channel>& channel, time_t start, time_t end, std::vector<data::EpgEntry>& entries)
+{
+  const bool useCache = m_settings->GetEPGCacheHours() > 0;
+
+  if (useCache && m_epgCache->GetEntries(channel->GetServiceReference(), channel->GetUniqueId(), start, end, entries))
+    return PVR_ERROR_NO_ERROR;
+
+  if (!m_settings->GetEPGLoadPerBouquet() || !GetBouquetEPG(channel, start, end, entries))
+  {
+    PVR_ERROR error = LoadChannelEPG(channel, start, end, entries);
+    if (error != PVR_ERROR_NO_ERROR)
+      return error;
+  }
+
+  if (useCache)
+  {
+    m_epgCache->SetEntries(channel->GetServiceReference(), start, end, entries);
+    m_epgCache->SaveIfRequired();
+  }
+
+  return PVR_ERROR_NO_ERROR;
+}
+
+PVR_ERROR Epg::LoadChannelEPG(const std::shared_ptr<data::Channel>& channel, time_t start, time_t end, std::vector<data::EpgEntry>& entries)
+{
+  const std::string url = StringUtils::Format("%s%s%s", m_settings->GetConnectionURL().c_str(),
+                                              "web/epgservice?sRef=", WebUtils::URLEncodeInline(channel->GetServiceReference()).c_str());
+
+  XmlFields eventFields(EpgEntry::GetXmlFieldTable());
+
+  XmlStreamReader xmlReader("e2eventlist", "e2event", [&](std::string_view element) {
+    eventFields.Read(element);
+
+    EpgEntry entry{m_settings};
+
+    if (entry.UpdateFrom(eventFields, channel, start, end))
+      entries.emplace_back(entry);
+
+    return true;
+  });
+
+  if (!LoadEPGXML(url, true, xmlReader))
+  {
+    Logger::Log(LEVEL_ERROR, "%s Unable to load EPG for channel: %s", __func__, channel->GetChannelName().c_str());
+    return PVR_ERROR_SERVER_ERROR;
+  }
+
+  if (!xmlReader.FoundListElement())
+  {
+    Logger::Log(LEVEL_WARNING, "%s could not find <e2eventlist> element for channel: %s", __func__, channel->GetChannelName().c_str());
+    // Return "NO_ERROR" as the EPG could be empty for this channel
+    return PVR_ERROR_NO_ERROR;
+  }
+
+  if (xmlReader.GetElementCount() == 0)
+  {
+    Logger::Log(LEVEL_WARNING, "%s Could not find <e2event> element for channel: %s", __func__, channel->GetChannelName().c_str());
+    // RETURN "NO_ERROR" as the EPG could be empty for this channel
+    return PVR_ERROR_NO_ERROR;
+  }
+
+  return PVR_ERROR_NO_ERROR;
+}
+
+bool Epg::GetBouquetEPG(const std::shared_ptr<data::Channel>& channel, time_t start, time_t end, std::vector<data::EpgEntry>& entries)
+{
+  std::lock_guard<std::mutex> lock(m_bouquetMutex);
+
+  time_t now = std::time(nullptr);
+  if (start != m_bouquetEntriesStart || end != m_bouquetEntriesEnd || now - m_bouquetEntriesLoadTime > BOUQUET_EPG_MAX_AGE_SECS)
+  {
+    m_bouquetEntries.clear();
+    m_loadedBouquets.clear();
+    m_bouquetEntriesStart = start;
+    m_bouquetEntriesEnd = end;
+    m_bouquetEntriesLoadTime = now;
+  }
+
+  auto entriesIt = m_bouquetEntries.find(channel->GetServiceReference());
+
+  if (entriesIt == m_bouquetEntries.end())
+  {
+    for (const auto& channelGroup : channel->GetChannelGroupList())
+    {
+      if (m_loadedBouquets.find(channelGroup->GetServiceReference()) != m_loadedBouquets.end())
+        continue;
+
+      if (LoadBouquetEPG(channelGroup, start, end))
+      {
+        entriesIt = m_bouquetEntries.find(channel->GetServiceReference());
+        break;
+      }
+    }
+
+    if (entriesIt == m_bouquetEntries.end())
+      return false;
+  }
+
+  // each channel is only requested once per EPG update so there is no need to hold on to its entries
+  entries = std::move(entriesIt->second);
+  m_bouquetEntries.erase(entriesIt);
+
+  return true;
+}
+
+bool Epg::LoadBouquetEPG(const std::shared_ptr<data::ChannelGroup>& channelGroup, time_t start, time_t end)
+{
+  m_loadedBouquets.insert(channelGroup->GetServiceReference());
+
+  const auto started = std::chrono::high_resolution_clock::now();
+
+  // endTime is in minutes from the start time
+  const long long durationMins = std::max<long long>((static_cast<long long>(end) - start) / 60, 1);
+  const std::string url = StringUtils::Format("%sweb/epgbouquet?bRef=%s&time=%lld&endTime=%lld", m_settings->GetConnectionURL().c_str(),
+                                              WebUtils::URLEncodeInline(channelGroup->GetServiceReference()).c_str(),
+                                              static_cast<long long>(start), durationMins);
+
+  // every member gets an entry, an empty list means the channel simply has no EPG
+  std::unordered_map<std::string, std::vector<EpgEntry>> bouquetEntries;
+  for (const auto& member : channelGroup->GetChannelGroupMembers())
+    bouquetEntries[member.GetChannel()->GetServiceReference()];
+
+  int numEntries = 0;
+  std::string serviceReference;
+
+  XmlFields eventFields(EpgEntry::GetXmlFieldTable());
+
+  XmlStreamReader xmlReader("e2eventlist", "e2event", [&](std::string_view element) {
+    eventFields.Read(element);
+
+    if (!eventFields.GetString("e2eventservicereference", serviceReference))
+      return true;
+
+    // Check whether the current element is not just a label
+    if (serviceReference.compare(0, 5, "1:64:") == 0)
+      return true;
+
+    std::shared_ptr<data::Channel> channel = m_channels.GetChannel(Channel::NormaliseServiceReference(serviceReference, m_settings->UseStandardServiceReference()));
+    if (!channel)
+      return true;
+
+    EpgEntry entry{m_settings};
+
+    if (entry.UpdateFrom(eventFields, channel, start, end))
+    {
+      bouquetEntries[channel->GetServiceReference()].emplace_back(entry);
+      numEntries++;
+    }
+
+    return true;
+  });
+
+  // a whole bouquet takes much longer than a single channel so it is not used to judge the response time
+  if (!LoadEPGXML(url, false, xmlReader))
+  {
+    Logger::Log(LEVEL_ERROR, "%s Unable to load EPG for bouquet: %s", __func__, channelGroup->GetGroupName().c_str());
+    return false;
+  }
+
+  if (!xmlReader.FoundListElement())
+  {
+    Logger::Log(LEVEL_WARNING, "%s could not find <e2eventlist> element for bouquet: %s", __func__, channelGroup->GetGroupName().c_str());
+    return false;
+  }
+
+  for (auto& channelEntries : bouquetEntries)
+    m_bouquetEntries[channelEntries.first] = std::move(channelEntries.second);
+
+  int milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - started).count();
+
+  Logger::Log(LEVEL_DEBUG, "%s Loaded %d EPG Entries for bouquet '%s' - %d (ms)", __func__, numEntries, channelGroup->GetGroupName().c_str(), milliseconds);
+
+  return true;
+}
+
 void Epg::SetEPGMaxPastDays(int epgMaxPastDays)
 {
   std::lock_guard<std::mutex> lock(m_mutex);
@@ -351,6 +550,30 @@ void Epg::UpdateTimerEPGFallbackEntries(const std::vector<enigma2::data::EpgEntr
   }
 }
 
+bool Epg::LoadEPGXML(const std::string& url, bool measureLatency, XmlStreamReader& xmlReader)
+{
+  m_rateLimiter->Acquire(m_settings->GetEPGDelayPerChannelDelay());
+
+  const auto started = std::chrono::steady_clock::now();
+
+  bool dataReceived = false;
+  const bool loaded = WebUtils::GetHttpStream(url, [&](const char* data, size_t size) {
+    dataReceived = true;
+    return xmlReader.AddData(data, size);
+  });
+
+  if (!loaded || !dataReceived)
+  {
+    m_rateLimiter->OnFailure();
+    return false;
+  }
+
+  if (measureLatency)
+    m_rateLimiter->OnResponse(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count());
+
+  return true;
+}
+
 int Epg::TransferTimerBasedEntries(kodi::addon::PVREPGTagsResultSet& results, int channelId)
 {
   int numTransferred = 0;
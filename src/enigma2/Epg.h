@@ -9,20 +9,27 @@
 
 #include "ChannelGroups.h"
 #include "Channels.h"
+#include "EpgCache.h"
 #include "InstanceSettings.h"
 #include "data/EpgPartialEntry.h"
 #include "extract/EpgEntryExtractor.h"
+#include "utilities/RateLimiter.h"
+#include "utilities/XmlStreamReader.h"
 
+#include <ctime>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace enigma2
 {
   static const float LAST_SCANNED_INITIAL_EPG_SUCCESS_PERCENT = 0.99f;
   static const int DEFAULT_EPG_MAX_DAYS = 3;
+  static const int BOUQUET_EPG_MAX_AGE_SECS = 10 * 60;
 
   class IConnectionListener;
 
@@ -35,6 +42,9 @@ namespace enigma2
     bool Initialise(enigma2::Channels& channels, enigma2::ChannelGroups& channelGroups);
     bool IsInitialEpgCompleted();
     PVR_ERROR GetEPGForChannel(const std::string& serviceReference, time_t start, time_t end, kodi::addon::PVREPGTagsResultSet& results);
+    bool HarvestEPGForChannel(const std::shared_ptr<data::Channel>& channel, time_t start, time_t end);
+    void ClearHarvestedEntries();
+    void GetEPGTimeWindow(time_t& start, time_t& end) const;
     void SetEPGMaxPastDays(int epgMaxPastDays);
     void SetEPGMaxFutureDays(int epgMaxFutureDays);
     std::string LoadEPGEntryShortDescription(const std::string& serviceReference, unsigned int epgUid);
@@ -44,6 +54,12 @@ namespace enigma2
     void UpdateTimerEPGFallbackEntries(const std::vector<enigma2::data::EpgEntry>& timerBasedEntries);
 
   private:
+    PVR_ERROR LoadEntries(const std::shared_ptr<data::Channel>& channel, time_t start, time_t end, std::vector<data::EpgEntry>& entries);
+    bool TakeHarvestedEntries(const std::shared_ptr<data::Channel>& channel, time_t start, time_t end, std::vector<data::EpgEntry>& entries);
+    PVR_ERROR LoadChannelEPG(const std::shared_ptr<data::Channel>& channel, time_t start, time_t end, std::vector<data::EpgEntry>& entries);
+    bool GetBouquetEPG(const std::shared_ptr<data::Channel>& channel, time_t start, time_t end, std::vector<data::EpgEntry>& entries);
+    bool LoadBouquetEPG(const std::shared_ptr<data::ChannelGroup>& channelGroup, time_t start, time_t end);
+    bool LoadEPGXML(const std::string& url, bool measureLatency, enigma2::utilities::XmlStreamReader& xmlReader);
     int TransferTimerBasedEntries(kodi::addon::PVREPGTagsResultSet& results, int channelId);
 
     enigma2::IConnectionListener& m_connectionListener;
@@ -59,6 +75,21 @@ namespace enigma2
 
     std::vector<data::EpgEntry> m_timerBasedEntries;
 
+    /*!< @brief entries from whole bouquet loads waiting to be requested per channel, only valid for the same time window */
+    std::unordered_map<std::string, std::vector<data::EpgEntry>> m_bouquetEntries;
+    std::unordered_set<std::string> m_loadedBouquets;
+    time_t m_bouquetEntriesStart = 0;
+    time_t m_bouquetEntriesEnd = 0;
+    time_t m_bouquetEntriesLoadTime = 0;
+    std::mutex m_bouquetMutex;
+
+    std::shared_ptr<enigma2::EpgCache> m_epgCache;
+    std::shared_ptr<enigma2::utilities::RateLimiter> m_rateLimiter;
+
+    /*!< @brief entries loaded in the background waiting for kodi to request them after an EPG update was triggered */
+    std::unordered_map<std::string, std::vector<data::EpgEntry>> m_harvestedEntries;
+    std::mutex m_harvestedMutex;
+
     mutable std::mutex m_mutex;
 
     std::shared_ptr<enigma2::InstanceSettings> m_settings;
@@ -0,0 +1,415 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#include "EpgCache.h"
+
+#include "utilities/FileUtils.h"
+#include "utilities/Logger.h"
+
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+
+#include <kodi/Filesystem.h>
+#include <kodi/tools/StringUtils.h>
+
+using namespace enigma2;
+using namespace enigma2::data;
+using namespace enigma2::utilities;
+using namespace kodi::tools;
+
+namespace
+{
+
+const char CACHE_FILE_MAGIC[] = {'E', '2', 'E', 'C'};
+
+enum EntryFlags : uint8_t
+{
+  FLAG_NEW = 0x01,
+  FLAG_LIVE = 0x02,
+  FLAG_PREMIERE = 0x04,
+  FLAG_FINALE = 0x08,
+};
+
+// All values are written little endian so the file does not depend on the platform
+
+void WriteUInt32(std::string& data, uint32_t value)
+{
+  for (int i = 0; i < 4; i++)
+    data.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+}
+
+void WriteInt64(std::string& data, int64_t value)
+{
+  for (int i = 0; i < 8; i++)
+    data.push_back(static_cast<char>((static_cast<uint64_t>(value) >> (i * 8)) & 0xFF));
+}
+
+void WriteString(std::string& data, const std::string& value)
+{
+  WriteUInt32(data, static_cast<uint32_t>(value.size()));
+  data.append(value);
+}
+
+class CacheReader
+{
+public:
+  CacheReader(const std::string& data) : m_data(data) {}
+
+  bool ReadUInt8(uint8_t& value)
+  {
+    if (m_pos + 1 > m_data.size())
+      return false;
+
+    value = static_cast<uint8_t>(m_data[m_pos++]);
+    return true;
+  }
+
+  bool ReadUInt32(uint32_t& value)
+  {
+    if (m_pos + 4 > m_data.size())
+      return false;
+
+    value = 0;
+    for (int i = 0; i < 4; i++)
+      value |= static_cast<uint32_t>(static_cast<uint8_t>(m_data[m_pos++])) << (i * 8);
+    return true;
+  }
+
+  bool ReadInt32(int& value)
+  {
+    uint32_t tmp;
+    if (!ReadUInt32(tmp))
+      return false;
+
+    value = static_cast<int32_t>(tmp);
+    return true;
+  }
+
+  bool ReadInt64(int64_t& value)
+  {
+    if (m_pos + 8 > m_data.size())
+      return false;
+
+    uint64_t tmp = 0;
+    for (int i = 0; i < 8; i++)
+      tmp |= static_cast<uint64_t>(static_cast<uint8_t>(m_data[m_pos++])) << (i * 8);
+    value = static_cast<int64_t>(tmp);
+    return true;
+  }
+
+  bool ReadTime(time_t& value)
+  {
+    int64_t tmp;
+    if (!ReadInt64(tmp))
+      return false;
+
+    value = static_cast<time_t>(tmp);
+    return true;
+  }
+
+  bool ReadString(std::string& value)
+  {
+    uint32_t size;
+    if (!ReadUInt32(size) || m_pos + size > m_data.size())
+      return false;
+
+    value.assign(m_data, m_pos, size);
+    m_pos += size;
+    return true;
+  }
+
+  bool ReadMagic()
+  {
+    if (m_pos + sizeof(CACHE_FILE_MAGIC) > m_data.size() ||
+        m_data.compare(m_pos, sizeof(CACHE_FILE_MAGIC), CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC)) != 0)
+      return false;
+
+    m_pos += sizeof(CACHE_FILE_MAGIC);
+    return true;
+  }
+
+private:
+  const std::string& m_data;
+  size_t m_pos = 0;
+};
+
+void WriteEntry(std::string& data, const EpgEntry& entry)
+{
+  WriteUInt32(data, entry.GetEpgId());
+  WriteInt64(data, entry.GetStartTime());
+  WriteInt64(data, entry.GetEndTime());
+  WriteString(data, entry.GetStartTimeW3CDate());
+  WriteString(data, entry.GetTitle());
+  WriteString(data, entry.GetPlotOutline());
+  WriteString(data, entry.GetPlot());
+  WriteUInt32(data, entry.GetGenreType());
+  WriteUInt32(data, entry.GetGenreSubType());
+  WriteString(data, entry.GetGenreDescription());
+  WriteUInt32(data, entry.GetSeasonNumber());
+  WriteUInt32(data, entry.GetEpisodeNumber());
+  WriteUInt32(data, entry.GetEpisodePartNumber());
+  WriteUInt32(data, entry.GetYear());
+
+  uint8_t flags = 0;
+  if (entry.IsNew())
+    flags |= FLAG_NEW;
+  if (entry.IsLive())
+    flags |= FLAG_LIVE;
+  if (entry.IsPremiere())
+    flags |= FLAG_PREMIERE;
+  if (entry.IsFinale())
+    flags |= FLAG_FINALE;
+  data.push_back(static_cast<char>(flags));
+}
+
+bool ReadEntry(CacheReader& reader, EpgEntry& entry)
+{
+  uint32_t epgId;
+  time_t startTime, endTime;
+  std::string startTimeW3CDate, title, plotOutline, plot, genreDescription;
+  int genreType, genreSubType, seasonNumber, episodeNumber, episodePartNumber, year;
+  uint8_t flags;
+
+  if (!reader.ReadUInt32(epgId) || !reader.ReadTime(startTime) || !reader.ReadTime(endTime) ||
+      !reader.ReadString(startTimeW3CDate) || !reader.ReadString(title) || !reader.ReadString(plotOutline) ||
+      !reader.ReadString(plot) || !reader.ReadInt32(genreType) || !reader.ReadInt32(genreSubType) ||
+      !reader.ReadString(genreDescription) || !reader.ReadInt32(seasonNumber) || !reader.ReadInt32(episodeNumber) ||
+      !reader.ReadInt32(episodePartNumber) || !reader.ReadInt32(year) || !reader.ReadUInt8(flags))
+    return false;
+
+  entry.SetEpgId(epgId);
+  entry.SetStartTime(startTime);
+  entry.SetEndTime(endTime);
+  entry.SetStartTimeW3CDate(startTimeW3CDate);
+  entry.SetTitle(title);
+  entry.SetPlotOutline(plotOutline);
+  entry.SetPlot(plot);
+  entry.SetGenreType(genreType);
+  entry.SetGenreSubType(genreSubType);
+  entry.SetGenreDescription(genreDescription);
+  entry.SetSeasonNumber(seasonNumber);
+  entry.SetEpisodeNumber(episodeNumber);
+  entry.SetEpisodePartNumber(episodePartNumber);
+  entry.SetYear(year);
+  entry.SetNew(flags & FLAG_NEW);
+  entry.SetLive(flags & FLAG_LIVE);
+  entry.SetPremiere(flags & FLAG_PREMIERE);
+  entry.SetFinale(flags & FLAG_FINALE);
+
+  return true;
+}
+
+} // unnamed namespace
+
+EpgCache::EpgCache(std::shared_ptr<enigma2::InstanceSettings>& settings) : m_settings(settings)
+{
+  m_cacheFile = GetCacheFile();
+}
+
+EpgCache::~EpgCache()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_dirty)
+    Save();
+}
+
+bool EpgCache::GetEntries(const std::string& serviceReference, int channelId, time_t start, time_t end, std::vector<EpgEntry>& entries)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (!m_loaded)
+    Load();
+
+  auto channelEntriesIt = m_channelEntries.find(serviceReference);
+  if (channelEntriesIt == m_channelEntries.end() || IsStale(channelEntriesIt->second, start, end))
+    return false;
+
+  for (const auto& cachedEntry : channelEntriesIt->second.m_entries)
+  {
+    // Same window as applied when the entries are loaded from the set-top box
+    if (start > cachedEntry.GetStartTime() || (end > 1 && end < cachedEntry.GetEndTime()))
+      continue;
+
+    EpgEntry entry = cachedEntry;
+    entry.SetServiceReference(serviceReference);
+    entry.SetChannelId(channelId);
+    entries.emplace_back(entry);
+  }
+
+  Logger::Log(LEVEL_DEBUG, "%s Using %d cached EPG entries for channel '%s'", __func__, static_cast<int>(entries.size()), serviceReference.c_str());
+
+  return true;
+}
+
+void EpgCache::SetEntries(const std::string& serviceReference, time_t start, time_t end, const std::vector<EpgEntry>& entries)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (!m_loaded)
+    Load();
+
+  ChannelEntries& channelEntries = m_channelEntries[serviceReference];
+  channelEntries.m_loadTime = std::time(nullptr);
+  channelEntries.m_windowStart = start;
+  channelEntries.m_windowEnd = end;
+  channelEntries.m_entries.clear();
+
+  // keyed by event ID, if the set-top box sends an event twice the last one wins
+  std::unordered_map<unsigned int, size_t> entryIndexes;
+  for (const auto& entry : entries)
+  {
+    auto entryIndexIt = entryIndexes.find(entry.GetEpgId());
+    if (entryIndexIt != entryIndexes.end())
+    {
+      channelEntries.m_entries[entryIndexIt->second] = entry;
+    }
+    else
+    {
+      entryIndexes[entry.GetEpgId()] = channelEntries.m_entries.size();
+      channelEntries.m_entries.emplace_back(entry);
+    }
+  }
+
+  m_dirty = true;
+}
+
+void EpgCache::SaveIfRequired()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_dirty && std::time(nullptr) - m_lastSaveTime >= SAVE_INTERVAL_SECS)
+    Save();
+}
+
+bool EpgCache::IsStale(const ChannelEntries& channelEntries, time_t start, time_t end) const
+{
+  const time_t now = std::time(nullptr);
+
+  if (now - channelEntries.m_loadTime > m_settings->GetEPGCacheHours() * 60 * 60 || now < channelEntries.m_loadTime)
+    return true;
+
+  // a window which moved forward needs the events past the end of the cached one
+  if (end > channelEntries.m_windowEnd + WINDOW_SIZE_TOLERANCE_SECS || start < channelEntries.m_windowStart - WINDOW_SIZE_TOLERANCE_SECS)
+    return true;
+
+  const long long cachedWindowSize = static_cast<long long>(channelEntries.m_windowEnd) - channelEntries.m_windowStart;
+  const long long windowSize = static_cast<long long>(end) - start;
+
+  return std::llabs(windowSize - cachedWindowSize) > WINDOW_SIZE_TOLERANCE_SECS;
+}
+
+void EpgCache::Load()
+{
+  m_loaded = true;
+
+  if (!FileUtils::FileExists(m_cacheFile))
+    return;
+
+  const auto started = std::chrono::high_resolution_clock::now();
+
+  const std::string data = FileUtils::ReadFileToString(m_cacheFile);
+  CacheReader reader(data);
+
+  uint32_t version = 0;
+  uint32_t channelCount = 0;
+  if (!reader.ReadMagic() || !reader.ReadUInt32(version) || version != CACHE_FILE_VERSION || !reader.ReadUInt32(channelCount))
+  {
+    Logger::Log(LEVEL_INFO, "%s Ignoring EPG cache file with unknown format: %s", __func__, m_cacheFile.c_str());
+    return;
+  }
+
+  std::unordered_map<std::string, ChannelEntries> channelEntriesMap;
+  int entryCount = 0;
+
+  for (uint32_t i = 0; i < channelCount; i++)
+  {
+    std::string serviceReference;
+    ChannelEntries channelEntries;
+    uint32_t channelEntryCount = 0;
+
+    if (!reader.ReadString(serviceReference) || !reader.ReadTime(channelEntries.m_loadTime) ||
+        !reader.ReadTime(channelEntries.m_windowStart) || !reader.ReadTime(channelEntries.m_windowEnd) ||
+        !reader.ReadUInt32(channelEntryCount))
+    {
+      Logger::Log(LEVEL_ERROR, "%s Ignoring corrupt EPG cache file: %s", __func__, m_cacheFile.c_str());
+      return;
+    }
+
+    for (uint32_t j = 0; j < channelEntryCount; j++)
+    {
+      EpgEntry entry{m_settings};
+      if (!ReadEntry(reader, entry))
+      {
+        Logger::Log(LEVEL_ERROR, "%s Ignoring corrupt EPG cache file: %s", __func__, m_cacheFile.c_str());
+        return;
+      }
+
+      entry.SetServiceReference(serviceReference);
+      channelEntries.m_entries.emplace_back(entry);
+    }
+
+    entryCount += channelEntries.m_entries.size();
+    channelEntriesMap[serviceReference] = std::move(channelEntries);
+  }
+
+  m_channelEntries = std::move(channelEntriesMap);
+
+  int milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - started).count();
+
+  Logger::Log(LEVEL_INFO, "%s Loaded %d cached EPG entries for %d channels - %d (ms)", __func__, entryCount, static_cast<int>(m_channelEntries.size()), milliseconds);
+}
+
+void EpgCache::Save()
+{
+  m_dirty = false;
+  m_lastSaveTime = std::time(nullptr);
+
+  std::string data(CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC));
+  WriteUInt32(data, CACHE_FILE_VERSION);
+  WriteUInt32(data, static_cast<uint32_t>(m_channelEntries.size()));
+
+  for (const auto& channelEntriesPair : m_channelEntries)
+  {
+    const ChannelEntries& channelEntries = channelEntriesPair.second;
+
+    WriteString(data, channelEntriesPair.first);
+    WriteInt64(data, channelEntries.m_loadTime);
+    WriteInt64(data, channelEntries.m_windowStart);
+    WriteInt64(data, channelEntries.m_windowEnd);
+    WriteUInt32(data, static_cast<uint32_t>(channelEntries.m_entries.size()));
+
+    for (const auto& entry : channelEntries.m_entries)
+      WriteEntry(data, entry);
+  }
+
+  kodi::vfs::CreateDirectory(EPG_CACHE_ADDON_DATA_BASE_DIR);
+
+  // Write to a temporary file first so a crash while saving never leaves a truncated cache behind
+  const std::string tmpCacheFile = m_cacheFile + ".tmp";
+  if (!FileUtils::WriteStringToFile(data, tmpCacheFile) || !kodi::vfs::RenameFile(tmpCacheFile, m_cacheFile))
+  {
+    Logger::Log(LEVEL_ERROR, "%s Unable to save EPG cache file: %s", __func__, m_cacheFile.c_str());
+    return;
+  }
+
+  Logger::Log(LEVEL_DEBUG, "%s Saved EPG cache for %d channels, %d bytes", __func__, static_cast<int>(m_channelEntries.size()), static_cast<int>(data.size()));
+}
+
+std::string EpgCache::GetCacheFile() const
+{
+  // One file per set-top box so multiple instances do not share entries
+  std::string name = StringUtils::Format("epg-%s-%d", m_settings->GetHostname().c_str(), m_settings->GetWebPortNum());
+  for (char& c : name)
+  {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '.')
+      c = '_';
+  }
+
+  return EPG_CACHE_ADDON_DATA_BASE_DIR + "/" + name + ".bin";
+}
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#pragma once
+
+#include "InstanceSettings.h"
+#include "data/EpgEntry.h"
+
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace enigma2
+{
+  static const std::string EPG_CACHE_DIR = "/epgCache";
+  static const std::string EPG_CACHE_ADDON_DATA_BASE_DIR = ADDON_DATA_BASE_DIR + EPG_CACHE_DIR;
+
+  /**
+   * Persistent store of the EPG entries loaded from the set-top box, keyed by
+   * service reference and event ID. Lets the EPG be served straight away after a
+   * restart and only channels whose entries are stale or whose time window has
+   * moved are loaded from the set-top box again.
+   */
+  class ATTR_DLL_LOCAL EpgCache
+  {
+  public:
+    EpgCache(std::shared_ptr<enigma2::InstanceSettings>& settings);
+    ~EpgCache();
+
+    bool GetEntries(const std::string& serviceReference, int channelId, time_t start, time_t end, std::vector<data::EpgEntry>& entries);
+    void SetEntries(const std::string& serviceReference, time_t start, time_t end, const std::vector<data::EpgEntry>& entries);
+    void SaveIfRequired();
+
+  private:
+    struct ChannelEntries
+    {
+      time_t m_loadTime = 0;
+      time_t m_windowStart = 0;
+      time_t m_windowEnd = 0;
+      std::vector<data::EpgEntry> m_entries;
+    };
+
+    bool IsStale(const ChannelEntries& channelEntries, time_t start, time_t end) const;
+    void Load();
+    void Save();
+    std::string GetCacheFile() const;
+
+    static const uint32_t CACHE_FILE_VERSION = 1;
+    static const int SAVE_INTERVAL_SECS = 60;
+    // the window kodi asks for moves with the clock so only a change in its size means the past/future days changed
+    static const int WINDOW_SIZE_TOLERANCE_SECS = 60 * 60;
+
+    std::shared_ptr<enigma2::InstanceSettings> m_settings;
+    std::string m_cacheFile;
+
+    std::unordered_map<std::string, ChannelEntries> m_channelEntries;
+    bool m_loaded = false;
+    bool m_dirty = false;
+    time_t m_lastSaveTime = 0;
+
+    std::mutex m_mutex;
+  };
+} //namespace enigma2
@@ -0,0 +1,151 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#include "EpgHarvester.h"
+
+#include "IConnectionListener.h"
+#include "utilities/Logger.h"
+#include "utilities/RequestScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace enigma2;
+using namespace enigma2::data;
+using namespace enigma2::utilities;
+
+EpgHarvester::EpgHarvester(IConnectionListener& connectionListener, enigma2::Epg& epg, enigma2::Channels& channels, std::shared_ptr<enigma2::InstanceSettings>& settings)
+  : m_connectionListener(connectionListener), m_epg(epg), m_channels(channels), m_settings(settings)
+{
+}
+
+EpgHarvester::~EpgHarvester()
+{
+  Stop();
+}
+
+void EpgHarvester::Start()
+{
+  Stop();
+
+  Logger::Log(LEVEL_INFO, "%s Starting EPG harvester with %d threads", __func__, m_settings->GetEPGHarvesterThreads());
+
+  m_running = true;
+  m_thread = std::thread([&] { Process(); });
+}
+
+void EpgHarvester::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_running = false;
+    m_pendingChannels.clear();
+  }
+  m_condition.notify_all();
+
+  if (m_thread.joinable())
+    m_thread.join();
+
+  m_epg.ClearHarvestedEntries();
+}
+
+void EpgHarvester::Process()
+{
+  while (m_running)
+  {
+    HarvestRound();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait_for(lock, std::chrono::seconds(HARVEST_INTERVAL_SECS), [this] { return !m_running; });
+  }
+}
+
+void EpgHarvester::HarvestRound()
+{
+  const auto started = std::chrono::high_resolution_clock::now();
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_epg.GetEPGTimeWindow(m_roundStart, m_roundEnd);
+
+    m_pendingChannels.clear();
+    for (const auto& channel : m_channels.GetChannelsList())
+      m_pendingChannels.emplace_back(channel);
+
+    m_channelsTotal = m_pendingChannels.size();
+    m_channelsHarvested = 0;
+    m_channelsFailed = 0;
+    m_lastLoggedPercent = 0;
+  }
+
+  // Bounded so that a weak set-top box is not flooded with concurrent requests
+  const int threadCount = std::max(1, std::min(m_settings->GetEPGHarvesterThreads(), m_channelsTotal.load()));
+  for (int i = 0; i < threadCount; i++)
+    m_workerThreads.emplace_back([&] { DoHarvest(); });
+
+  for (auto& workerThread : m_workerThreads)
+    workerThread.join();
+  m_workerThreads.clear();
+
+  if (!m_running)
+    return;
+
+  int milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - started).count();
+
+  Logger::Log(LEVEL_INFO, "%s Harvested EPG for %d of %d channels, %d failed - %d (ms)", __func__, m_channelsHarvested.load(), m_channelsTotal.load(), m_channelsFailed.load(), milliseconds);
+}
+
+void EpgHarvester::DoHarvest()
+{
+  RequestPriorityScope priorityScope(RequestPriority::BACKGROUND);
+
+  while (m_running)
+  {
+    std::shared_ptr<Channel> channel;
+    time_t start, end;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      if (m_pendingChannels.empty())
+        return;
+
+      channel = m_pendingChannels.front();
+      m_pendingChannels.pop_front();
+      start = m_roundStart;
+      end = m_roundEnd;
+    }
+
+    if (m_epg.HarvestEPGForChannel(channel, start, end))
+    {
+      m_channelsHarvested++;
+      // kodi will now request the entries for this channel which are served from memory
+      m_connectionListener.TriggerEpgUpdate(channel->GetUniqueId());
+    }
+    else
+    {
+      m_channelsFailed++;
+      Logger::Log(LEVEL_DEBUG, "%s Unable to harvest EPG for channel '%s'", __func__, channel->GetChannelName().c_str());
+    }
+
+    LogProgress();
+  }
+}
+
+void EpgHarvester::LogProgress()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const int channelsDone = m_channelsHarvested + m_channelsFailed;
+  const int percent = m_channelsTotal > 0 ? channelsDone * 100 / m_channelsTotal : 100;
+
+  if (percent >= m_lastLoggedPercent + PROGRESS_LOG_STEP_PERCENT)
+  {
+    m_lastLoggedPercent = percent - (percent % PROGRESS_LOG_STEP_PERCENT);
+    Logger::Log(LEVEL_DEBUG, "%s EPG harvest %d%% done, %d of %d channels", __func__, percent, channelsDone, m_channelsTotal.load());
+  }
+}
@@ -0,0 +1,75 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#pragma once
+
+#include "Channels.h"
+#include "Epg.h"
+#include "InstanceSettings.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace enigma2
+{
+  class IConnectionListener;
+
+  /**
+   * Loads the EPG for all channels in the background and asks kodi to fetch
+   * each channel once its entries are ready, so kodi never has to wait on the
+   * set-top box. Used when the EPG is transferred asynchronously.
+   */
+  class ATTR_DLL_LOCAL EpgHarvester
+  {
+  public:
+    EpgHarvester(IConnectionListener& connectionListener, enigma2::Epg& epg, enigma2::Channels& channels, std::shared_ptr<enigma2::InstanceSettings>& settings);
+    ~EpgHarvester();
+
+    void Start();
+    void Stop();
+
+    bool IsRunning() const { return m_running; }
+    int GetChannelsTotal() const { return m_channelsTotal; }
+    int GetChannelsHarvested() const { return m_channelsHarvested; }
+    int GetChannelsFailed() const { return m_channelsFailed; }
+
+  private:
+    void Process();
+    void DoHarvest();
+    void HarvestRound();
+    void LogProgress();
+
+    // Kodi's own default EPG update interval
+    static const int HARVEST_INTERVAL_SECS = 2 * 60 * 60;
+    static const int PROGRESS_LOG_STEP_PERCENT = 10;
+
+    IConnectionListener& m_connectionListener;
+    enigma2::Epg& m_epg;
+    enigma2::Channels& m_channels;
+    std::shared_ptr<enigma2::InstanceSettings> m_settings;
+
+    std::atomic<bool> m_running = {false};
+    std::thread m_thread;
+    std::vector<std::thread> m_workerThreads;
+
+    std::deque<std::shared_ptr<data::Channel>> m_pendingChannels;
+    time_t m_roundStart = 0;
+    time_t m_roundEnd = 0;
+    int m_lastLoggedPercent = 0;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    std::atomic<int> m_channelsTotal = {0};
+    std::atomic<int> m_channelsHarvested = {0};
+    std::atomic<int> m_channelsFailed = {0};
+  };
+} // namespace enigma2
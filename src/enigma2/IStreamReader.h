@@ -24,6 +24,7 @@ namespace enigma2
     virtual int64_t Length() = 0;
     virtual std::time_t TimeStart() = 0;
     virtual std::time_t TimeEnd() = 0;
+    virtual int64_t DurationMs() = 0;
     virtual bool IsRealTime() = 0;
     virtual bool IsTimeshifting() = 0;
     virtual bool HasTimeshiftCapacity() = 0;
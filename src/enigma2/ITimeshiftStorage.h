@@ -0,0 +1,30 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <kodi/Filesystem.h>
+
+namespace enigma2
+{
+  /**
+   * Storage for the data of a timeshift buffer. Data is always appended and is
+   * addressed by its position in the stream, i.e. the number of bytes written
+   * before it, regardless of where it is actually stored.
+   */
+  class ATTR_DLL_LOCAL ITimeshiftStorage
+  {
+  public:
+    virtual ~ITimeshiftStorage() = default;
+    virtual bool IsOpen() = 0;
+    virtual ssize_t Write(const uint8_t* buffer, size_t size) = 0;
+    virtual ssize_t Read(uint64_t position, uint8_t* buffer, size_t size) = 0;
+    virtual uint64_t GetReadableStartPosition() = 0;
+  };
+} // namespace enigma2
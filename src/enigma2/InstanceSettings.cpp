@@ -132,6 +132,10 @@ void InstanceSettings::ReadSettings()
   m_instance.CheckInstanceSettingString("rytecgenretextmapfile", m_mapRytecTextGenresFile);
   m_instance.CheckInstanceSettingBoolean("logmissinggenremapping", m_logMissingGenreMappings);
   m_instance.CheckInstanceSettingInt("epgdelayperchannel", m_epgDelayPerChannel);
+  m_instance.CheckInstanceSettingBoolean("epgloadperbouquet", m_epgLoadPerBouquet);
+  m_instance.CheckInstanceSettingInt("epgcachehours", m_epgCacheHours);
+  m_instance.CheckInstanceSettingBoolean("epgasynctransfer", m_epgAsyncTransfer);
+  m_instance.CheckInstanceSettingInt("epgharvesterthreads", m_epgHarvesterThreads);
 
   //Recording
   m_instance.CheckInstanceSettingBoolean("storeextrarecordinginfo", m_storeLastPlayedAndCount);
@@ -144,6 +148,7 @@ void InstanceSettings::ReadSettings()
   m_instance.CheckInstanceSettingBoolean("enablerecordingedls", m_enableRecordingEDLs);
   m_instance.CheckInstanceSettingInt("edlpaddingstart", m_edlStartTimePadding);
   m_instance.CheckInstanceSettingInt("edlpaddingstop", m_edlStopTimePadding);
+  m_instance.CheckInstanceSettingInt("recordingreadahead", m_recordingReadAheadMB);
 
   //Timers
   m_instance.CheckInstanceSettingBoolean("enablegenrepeattimers", m_enableGenRepeatTimers);
@@ -156,9 +161,13 @@ void InstanceSettings::ReadSettings()
 
   //Timeshift
   m_instance.CheckInstanceSettingEnum<Timeshift>("enabletimeshift", m_timeshift);
+  m_instance.CheckInstanceSettingEnum<TimeshiftBufferType>("timeshiftbuffertype", m_timeshiftBufferType);
   m_instance.CheckInstanceSettingString("timeshiftbufferpath", m_timeshiftBufferPath);
+  m_instance.CheckInstanceSettingInt("timeshiftmemorysize", m_timeshiftMemoryBufferMB);
+  m_instance.CheckInstanceSettingBoolean("timeshiftsegmentfiles", m_timeshiftSegmentFiles);
   m_instance.CheckInstanceSettingBoolean("enabletimeshiftdisklimit", m_enableTimeshiftDiskLimit);
   m_instance.CheckInstanceSettingFloat("timeshiftdisklimit", m_timeshiftDiskLimitGB);
+  m_instance.CheckInstanceSettingEnum<TimeshiftDiskLimitMode>("timeshiftdisklimitmode", m_timeshiftDiskLimitMode);
   m_instance.CheckInstanceSettingBoolean("timeshiftEnabledIptv", m_timeshiftEnabledIptv);
   m_instance.CheckInstanceSettingBoolean("useFFmpegReconnect", m_useFFmpegReconnect);
   m_instance.CheckInstanceSettingBoolean("useMpegtsForUnknownStreams", m_useMpegtsForUnknownStreams);
@@ -298,6 +307,14 @@ ADDON_STATUS InstanceSettings::SetSetting(const std::string& settingName, const
     return SetSetting<bool, ADDON_STATUS>(settingName, settingValue, m_logMissingGenreMappings, ADDON_STATUS_OK, ADDON_STATUS_OK);
   else if (settingName == "epgdelayperchannel")
     return SetSetting<int, ADDON_STATUS>(settingName, settingValue, m_epgDelayPerChannel, ADDON_STATUS_OK, ADDON_STATUS_OK);
+  else if (settingName == "epgloadperbouquet")
+    return SetSetting<bool, ADDON_STATUS>(settingName, settingValue, m_epgLoadPerBouquet, ADDON_STATUS_OK, ADDON_STATUS_OK);
+  else if (settingName == "epgcachehours")
+    return SetSetting<int, ADDON_STATUS>(settingName, settingValue, m_epgCacheHours, ADDON_STATUS_OK, ADDON_STATUS_OK);
+  else if (settingName == "epgasynctransfer")
+    return SetSetting<bool, ADDON_STATUS>(settingName, settingValue, m_epgAsyncTransfer, ADDON_STATUS_NEED_RESTART, ADDON_STATUS_OK);
+  else if (settingName == "epgharvesterthreads")
+    return SetSetting<int, ADDON_STATUS>(settingName, settingValue, m_epgHarvesterThreads, ADDON_STATUS_NEED_RESTART, ADDON_STATUS_OK);
   //Recordings
   else if (settingName == "storeextrarecordinginfo")
     return SetSetting<bool, ADDON_STATUS>(settingName, settingValue, m_storeLastPlayedAndCount, ADDON_STATUS_NEED_RESTART, ADDON_STATUS_OK);
@@ -319,6 +336,8 @@ ADDON_STATUS InstanceSettings::SetSetting(const std::string& settingName, const
     return SetSetting<int, ADDON_STATUS>(settingName, settingValue, m_edlStartTimePadding, ADDON_STATUS_OK, ADDON_STATUS_OK);
   else if (settingName == "edlpaddingstop")
     return SetSetting<int, ADDON_STATUS>(settingName, settingValue, m_edlStopTimePadding, ADDON_STATUS_OK, ADDON_STATUS_OK);
+  else if (settingName == "recordingreadahead")
+    return SetSetting<int, ADDON_STATUS>(settingName, settingValue, m_recordingReadAheadMB, ADDON_STATUS_OK, ADDON_STATUS_OK);
   //Timers
   else if (settingName == "enablegenrepeattimers")
     return SetSetting<bool, ADDON_STATUS>(settingName, settingValue, m_enableGenRepeatTimers, ADDON_STATUS_OK, ADDON_STATUS_OK);
@@ -337,12 +356,20 @@ ADDON_STATUS InstanceSettings::SetSetting(const std::string& settingName, const
    //Timeshift
   else if (settingName == "enabletimeshift")
     return SetEnumSetting<Timeshift, ADDON_STATUS>(settingName, settingValue, m_timeshift, ADDON_STATUS_NEED_RESTART, ADDON_STATUS_OK);
+  else if (settingName == "timeshiftbuffertype")
+    return SetEnumSetting<TimeshiftBufferType, ADDON_STATUS>(settingName, settingValue, m_timeshiftBufferType, ADDON_STATUS_OK, ADDON_STATUS_OK);
   else if (settingName == "timeshiftbufferpath")
     return SetStringSetting<ADDON_STATUS>(settingName, settingValue, m_timeshiftBufferPath, ADDON_STATUS_OK, ADDON_STATUS_OK);
+  else if (settingName == "timeshiftmemorysize")
+    return SetSetting<int, ADDON_STATUS>(settingName, settingValue, m_timeshiftMemoryBufferMB, ADDON_STATUS_OK, ADDON_STATUS_OK);
+  else if (settingName == "timeshiftsegmentfiles")
+    return SetSetting<bool, ADDON_STATUS>(settingName, settingValue, m_timeshiftSegmentFiles, ADDON_STATUS_OK, ADDON_STATUS_OK);
   else if (settingName == "enabletimeshiftdisklimit")
     return SetSetting<bool, ADDON_STATUS>(settingName, settingValue, m_enableTimeshiftDiskLimit, ADDON_STATUS_OK, ADDON_STATUS_OK);
   else if (settingName == "timeshiftdisklimit")
     return SetSetting<float, ADDON_STATUS>(settingName, settingValue, m_timeshiftDiskLimitGB, ADDON_STATUS_OK, ADDON_STATUS_OK);
+  else if (settingName == "timeshiftdisklimitmode")
+    return SetEnumSetting<TimeshiftDiskLimitMode, ADDON_STATUS>(settingName, settingValue, m_timeshiftDiskLimitMode, ADDON_STATUS_OK, ADDON_STATUS_OK);
   else if (settingName == "timeshiftEnabledIptv")
     return SetSetting<bool, ADDON_STATUS>(settingName, settingValue, m_timeshiftEnabledIptv, ADDON_STATUS_OK, ADDON_STATUS_OK);
   else if (settingName == "useFFmpegReconnect")
@@ -380,6 +407,11 @@ bool InstanceSettings::IsTimeshiftBufferPathValid() const
   return kodi::vfs::DirectoryExists(m_timeshiftBufferPath) || kodi::vfs::DirectoryExists(ADDON_DATA_BASE_DIR);
 }
 
+bool InstanceSettings::IsTimeshiftBufferAvailable() const
+{
+  return m_timeshiftBufferType == TimeshiftBufferType::MEMORY || IsTimeshiftBufferPathValid();
+}
+
 bool InstanceSettings::LoadCustomChannelGroupFile(std::string& xmlFile, std::vector<std::string>& channelGroupNameList)
 {
   channelGroupNameList.clear();
@@ -433,7 +465,7 @@ bool InstanceSettings::LoadCustomChannelGroupFile(std::string& xmlFile, std::vec
 
     channelGroupNameList.emplace_back(channelGroupName);
 
-    Logger::Log(LEVEL_TRACE, "%s Read Custom ChannelGroup Name: %s, from file: %s", __func__, channelGroupName.c_str(), xmlFile.c_str());
+    VUPLUS_LOG(LEVEL_TRACE, "%s Read Custom ChannelGroup Name: %s, from file: %s", __func__, channelGroupName.c_str(), xmlFile.c_str());
   }
 
   return true;
@@ -87,6 +87,20 @@ namespace enigma2
     ON_PAUSE
   };
 
+  enum class TimeshiftBufferType
+    : int // same type as addon settings
+  {
+    DISK = 0,
+    MEMORY
+  };
+
+  enum class TimeshiftDiskLimitMode
+    : int // same type as addon settings
+  {
+    SWITCH_TO_LIVE = 0,
+    WRAP_AROUND
+  };
+
   enum class PrependOutline
     : int // same type as addon settings
   {
@@ -163,6 +177,10 @@ namespace enigma2
     const std::string& GetMapRytecTextGenresFile() const { return m_mapRytecTextGenresFile; }
     bool GetLogMissingGenreMappings() const { return m_logMissingGenreMappings; }
     int GetEPGDelayPerChannelDelay() const { return m_epgDelayPerChannel; }
+    bool GetEPGLoadPerBouquet() const { return m_epgLoadPerBouquet; }
+    int GetEPGCacheHours() const { return m_epgCacheHours; }
+    bool GetEPGAsyncTransfer() const { return m_epgAsyncTransfer; }
+    int GetEPGHarvesterThreads() const { return m_epgHarvesterThreads; }
 
     //Recordings
     bool GetStoreRecordingLastPlayedAndCount() const { return m_storeLastPlayedAndCount; }
@@ -175,6 +193,7 @@ namespace enigma2
     bool GetRecordingEDLsEnabled() const { return m_enableRecordingEDLs; }
     int GetEDLStartTimePadding() const { return m_edlStartTimePadding; }
     int GetEDLStopTimePadding() const { return m_edlStopTimePadding; }
+    uint64_t GetRecordingReadAheadBytes() const { return static_cast<uint64_t>(1024LL * 1024LL * m_recordingReadAheadMB); }
 
     //Timers
     bool GetGenRepeatTimersEnabled() const { return m_enableGenRepeatTimers; }
@@ -187,11 +206,16 @@ namespace enigma2
 
     //Timeshift
     const Timeshift& GetTimeshift() const { return m_timeshift; }
+    const TimeshiftBufferType& GetTimeshiftBufferType() const { return m_timeshiftBufferType; }
     const std::string& GetTimeshiftBufferPath() const { return m_timeshiftBufferPath; }
     bool IsTimeshiftBufferPathValid() const;
+    bool IsTimeshiftBufferAvailable() const;
+    uint64_t GetTimeshiftMemoryBufferBytes() const { return static_cast<uint64_t>(1024LL * 1024LL * m_timeshiftMemoryBufferMB); }
+    bool UseTimeshiftSegmentFiles() const { return m_timeshiftSegmentFiles; }
     bool EnableTimeshiftDiskLimit() const { return m_enableTimeshiftDiskLimit; };
     float GetTimeshiftDiskLimitGB() const { return m_timeshiftDiskLimitGB; };
     uint64_t GetTimeshiftDiskLimitBytes() const { return static_cast<uint64_t>(1024LL * 1024LL * 1024LL * m_timeshiftDiskLimitGB); }
+    TimeshiftDiskLimitMode GetTimeshiftDiskLimitMode() const { return m_timeshiftDiskLimitMode; }
     bool IsTimeshiftEnabledIptv() const { return m_timeshiftEnabledIptv; }
     bool UseFFmpegReconnect() const { return m_useFFmpegReconnect; }
     bool UseMpegtsForUnknownStreams() const { return m_useMpegtsForUnknownStreams; }
@@ -376,6 +400,10 @@ namespace enigma2
     std::string m_mapRytecTextGenresFile = DEFAULT_GENRE_TEXT_MAP_FILE;
     bool m_logMissingGenreMappings = true;
     int m_epgDelayPerChannel = 0;
+    bool m_epgLoadPerBouquet = true;
+    int m_epgCacheHours = 6;
+    bool m_epgAsyncTransfer = true;
+    int m_epgHarvesterThreads = 2;
 
     //Recordings
     bool m_storeLastPlayedAndCount = true;
@@ -389,6 +417,7 @@ namespace enigma2
     bool m_enableRecordingEDLs = false;
     int m_edlStartTimePadding = 0;
     int m_edlStopTimePadding = 0;
+    int m_recordingReadAheadMB = 16;
 
     //Timers
     bool m_enableGenRepeatTimers = true;
@@ -400,9 +429,13 @@ namespace enigma2
 
     //Timeshift
     Timeshift m_timeshift = Timeshift::OFF;
+    TimeshiftBufferType m_timeshiftBufferType = TimeshiftBufferType::DISK;
     std::string m_timeshiftBufferPath = ADDON_DATA_BASE_DIR;
+    int m_timeshiftMemoryBufferMB = 256;
+    bool m_timeshiftSegmentFiles = false;
     bool m_enableTimeshiftDiskLimit = false;
     float m_timeshiftDiskLimitGB = 4.0f;
+    TimeshiftDiskLimitMode m_timeshiftDiskLimitMode = TimeshiftDiskLimitMode::SWITCH_TO_LIVE;
     bool m_timeshiftEnabledIptv = true;
     bool m_useFFmpegReconnect = true;
     bool m_useMpegtsForUnknownStreams = true;
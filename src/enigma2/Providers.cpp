@@ -272,7 +272,7 @@ bool Providers::LoadProviderMappingFile(const std::string& xmlFile)
 
       m_providerMappingsMap.insert({mappedName, provider});
 
-      Logger::Log(LEVEL_TRACE, "%s Read Provider Mapping from: %s to %s", __func__, mappedName.c_str(), provider.GetProviderName().c_str());
+      VUPLUS_LOG(LEVEL_TRACE, "%s Read Provider Mapping from: %s to %s", __func__, mappedName.c_str(), provider.GetProviderName().c_str());
     }
   }
 
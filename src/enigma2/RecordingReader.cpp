@@ -10,17 +10,18 @@
 #include "utilities/Logger.h"
 
 #include <algorithm>
+#include <chrono>
 
 using namespace enigma2;
 using namespace enigma2::utilities;
 
-RecordingReader::RecordingReader(const std::string& streamURL, std::time_t start, std::time_t end, int duration)
+RecordingReader::RecordingReader(const std::string& streamURL, std::time_t start, std::time_t end, int duration, uint64_t readAheadSize)
   : m_streamURL(streamURL), m_start(start), m_end(end), m_duration(duration)
 {
   m_readHandle.CURLCreate(m_streamURL);
   m_readHandle.CURLOpen(ADDON_READ_NO_CACHE);
   m_len = m_readHandle.GetLength();
-  m_nextReopen = std::time(nullptr) + REOPEN_INTERVAL;
+  m_followLen = m_len.load();
 
   //If this is an ongoing recording set the duration to the eventual length of the recording
   if (start > 0 && end > 0)
@@ -28,37 +29,113 @@ RecordingReader::RecordingReader(const std::string& streamURL, std::time_t start
     m_duration = static_cast<int>(end - start);
   }
 
-  Logger::Log(LEVEL_DEBUG, "%s RecordingReader: Started - url=%s, start=%lld, end=%lld, duration=%d", __func__, m_streamURL.c_str(),
-              static_cast<long long>(m_start), static_cast<long long>(m_end), m_duration);
+  // the cache needs room for at least a few blocks to be of any use
+  if (readAheadSize >= 4 * READ_AHEAD_BLOCK_SIZE)
+    m_cache.resize(readAheadSize);
+
+  Logger::Log(LEVEL_DEBUG, "%s RecordingReader: Started - url=%s, start=%lld, end=%lld, duration=%d, read ahead=%lld", __func__, m_streamURL.c_str(),
+              static_cast<long long>(m_start), static_cast<long long>(m_end), m_duration, static_cast<long long>(m_cache.size()));
 }
 
 RecordingReader::~RecordingReader()
 {
+  m_running = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_condition.notify_all();
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_followMutex);
+    m_followCondition.notify_all();
+  }
+  if (m_readAheadThread.joinable())
+    m_readAheadThread.join();
+  if (m_followThread.joinable())
+    m_followThread.join();
+  if (m_accessPointsThread.joinable())
+    m_accessPointsThread.join();
+
   Logger::Log(LEVEL_DEBUG, "%s RecordingReader: Stopped", __func__);
 }
 
 bool RecordingReader::Start()
 {
-  return (m_readHandle.IsOpen());
+  if (!m_readHandle.IsOpen())
+    return false;
+
+  if (m_running)
+    return true;
+
+  m_running = true;
+  if (!m_cache.empty())
+    m_readAheadThread = std::thread([&] { DoReadAhead(); });
+  if (m_end)
+    m_followThread = std::thread([&] { DoFollow(); });
+  else
+    m_accessPointsThread = std::thread([&] { LoadAccessPoints(); });
+
+  return true;
 }
 
-ssize_t RecordingReader::ReadData(unsigned char* buffer, unsigned int size)
+void RecordingReader::DoFollow()
 {
-  /* check for playback of ongoing recording */
-  if (m_end)
+  Logger::Log(LEVEL_DEBUG, "%s RecordingReader: Follow thread started", __func__);
+
+  int probeInterval = FOLLOW_PROBE_INTERVAL_MIN;
+  uint64_t lastLength = m_followLen;
+  std::time_t lastGrowth = std::time(nullptr);
+
+  while (m_running)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_followMutex);
+      m_followCondition.wait_for(lock, std::chrono::seconds(probeInterval), [&] { return !m_running.load(); });
+    }
+
+    if (!m_running)
+      break;
+
+    /* a HEAD request is far cheaper than reopening the stream */
+    std::time_t now = std::time(nullptr);
+    bool recordingFinished = now > m_end;
+    kodi::vfs::FileStatus status;
+    if (kodi::vfs::StatFile(m_streamURL, status) && status.GetSize() > lastLength)
+    {
+      uint64_t length = status.GetSize();
+
+      // aim for the next probe once about FOLLOW_PROBE_BYTES more have been recorded
+      uint64_t bytesPerSecond = (length - lastLength) / std::max<std::time_t>(now - lastGrowth, 1);
+      probeInterval = static_cast<int>(FOLLOW_PROBE_BYTES / std::max<uint64_t>(bytesPerSecond, 1));
+      probeInterval = std::min(std::max(probeInterval, FOLLOW_PROBE_INTERVAL_MIN), FOLLOW_PROBE_INTERVAL_MAX);
+
+      Logger::Log(LEVEL_DEBUG, "%s RecordingReader: Recording grew to %lld bytes at %lld bytes/s, next probe in %ds", __func__,
+                  static_cast<long long>(length), static_cast<long long>(bytesPerSecond), probeInterval);
+
+      m_followLen = lastLength = length;
+      lastGrowth = now;
+    }
+
+    /* one last probe after the end of the recording is all that is needed */
+    if (recordingFinished)
+      break;
+  }
+
+  Logger::Log(LEVEL_DEBUG, "%s RecordingReader: Follow thread stopped", __func__);
+}
+
+ssize_t RecordingReader::ReadFromHandle(unsigned char* buffer, unsigned int size)
+{
+  /* check for playback of ongoing recording, the read ahead thread only reopens once the follow thread saw more being recorded */
+  if (m_end && m_handlePos >= m_len)
   {
     std::time_t now = std::time(nullptr);
-    if (m_pos == m_len || now > m_nextReopen)
+    if (m_followLen > m_len || now > m_end || m_cache.empty())
     {
       /* reopen stream */
       Logger::Log(LEVEL_DEBUG, "%s RecordingReader: Reopening stream...", __func__);
       m_readHandle.CURLOpen(ADDON_READ_REOPEN | ADDON_READ_NO_CACHE);
       m_len = m_readHandle.GetLength();
-      m_readHandle.Seek(m_pos, SEEK_SET);
-
-      // random value (10 MiB) we choose to switch to fast reopen interval
-      bool nearEnd = m_len - m_pos <= 10 * 1024 * 1024;
-      m_nextReopen = now + (nearEnd ? REOPEN_INTERVAL_FAST : REOPEN_INTERVAL);
+      m_readHandle.Seek(m_handlePos, SEEK_SET);
 
       /* recording has finished */
       if (now > m_end)
@@ -67,28 +144,246 @@ ssize_t RecordingReader::ReadData(unsigned char* buffer, unsigned int size)
   }
 
   ssize_t read = m_readHandle.Read(buffer, size);
-  m_pos += read;
+  if (read > 0)
+    m_handlePos += read;
   return read;
 }
 
+void RecordingReader::DoReadAhead()
+{
+  Logger::Log(LEVEL_DEBUG, "%s RecordingReader: Read ahead thread started", __func__);
+
+  std::vector<unsigned char> buffer(READ_AHEAD_BLOCK_SIZE);
+  bool reopen = false;
+  while (m_running)
+  {
+    uint64_t readPos;
+    unsigned int generation;
+    {
+      /* wait until a block fits without dropping data which has not been read yet */
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [&] {
+        return !m_running || (!m_cacheEof && m_cacheEnd - m_pos + READ_AHEAD_BLOCK_SIZE <= m_cache.size());
+      });
+
+      if (!m_running)
+        break;
+
+      readPos = m_cacheEnd;
+      generation = m_cacheGeneration;
+    }
+
+    if (reopen)
+    {
+      Logger::Log(LEVEL_DEBUG, "%s RecordingReader: Reopening stream after read error...", __func__);
+      m_readHandle.CURLOpen(ADDON_READ_REOPEN | ADDON_READ_NO_CACHE);
+      m_len = m_readHandle.GetLength();
+      m_handlePos = 0;
+      reopen = false;
+    }
+
+    if (m_handlePos != readPos)
+    {
+      m_readHandle.Seek(readPos, SEEK_SET);
+      m_handlePos = readPos;
+    }
+
+    ssize_t read = ReadFromHandle(buffer.data(), READ_AHEAD_BLOCK_SIZE);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    /* a seek outside of the cache moved the window, what we read is of no use anymore */
+    if (generation != m_cacheGeneration)
+      continue;
+
+    if (read > 0)
+    {
+      uint64_t cacheOffset = m_cacheEnd % m_cache.size();
+      size_t firstSize = std::min<uint64_t>(read, m_cache.size() - cacheOffset);
+      std::copy(buffer.begin(), buffer.begin() + firstSize, m_cache.begin() + cacheOffset);
+      std::copy(buffer.begin() + firstSize, buffer.begin() + read, m_cache.begin());
+
+      m_cacheEnd += read;
+      if (m_cacheEnd - m_cacheStart > m_cache.size())
+        m_cacheStart = m_cacheEnd - m_cache.size();
+
+      m_condition.notify_all();
+    }
+    else if (read == 0 && !m_end)
+    {
+      m_cacheEof = true;
+      m_condition.notify_all();
+    }
+    else
+    {
+      /* a network error or an ongoing recording which has not grown yet, try again shortly */
+      reopen = read < 0;
+      m_condition.wait_for(lock, std::chrono::milliseconds(READ_AHEAD_RETRY_WAITTIME),
+                           [&] { return !m_running || generation != m_cacheGeneration; });
+    }
+  }
+
+  Logger::Log(LEVEL_DEBUG, "%s RecordingReader: Read ahead thread stopped", __func__);
+}
+
+ssize_t RecordingReader::ReadData(unsigned char* buffer, unsigned int size)
+{
+  if (m_cache.empty())
+  {
+    ssize_t read = ReadFromHandle(buffer, size);
+
+    /* at the live edge of an ongoing recording wait for more to be recorded, as Kodi takes a read of 0 as the end of the file */
+    std::time_t timeout = std::time(nullptr) + READ_AHEAD_TIMEOUT;
+    while (read == 0 && m_end && m_running && std::time(nullptr) < timeout)
+    {
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait_for(lock, std::chrono::milliseconds(READ_AHEAD_RETRY_WAITTIME), [&] { return !m_running.load(); });
+      }
+      read = ReadFromHandle(buffer, size);
+    }
+
+    m_pos = m_handlePos;
+    return read;
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  bool available = m_condition.wait_for(lock, std::chrono::seconds(READ_AHEAD_TIMEOUT),
+                                        [&] { return m_pos < m_cacheEnd || m_cacheEof; });
+
+  if (m_pos >= m_cacheEnd)
+  {
+    if (!available)
+      Logger::Log(LEVEL_DEBUG, "%s RecordingReader: Read timed out; waited %d", __func__, READ_AHEAD_TIMEOUT);
+    return available ? 0 : -1;
+  }
+
+  size_t readSize = std::min<uint64_t>(size, m_cacheEnd - m_pos);
+  uint64_t cacheOffset = m_pos % m_cache.size();
+  size_t firstSize = std::min<uint64_t>(readSize, m_cache.size() - cacheOffset);
+  std::copy(m_cache.begin() + cacheOffset, m_cache.begin() + cacheOffset + firstSize, buffer);
+  std::copy(m_cache.begin(), m_cache.begin() + (readSize - firstSize), buffer + firstSize);
+
+  m_pos += readSize;
+  m_condition.notify_all();
+
+  return readSize;
+}
+
+bool RecordingReader::ReadAccessPointPts(kodi::vfs::CFile& file, int64_t position, uint64_t& pts)
+{
+  if (file.Seek(position, SEEK_SET) != position)
+    return false;
+
+  uint8_t entry[ACCESS_POINT_ENTRY_SIZE];
+  ssize_t size = 0;
+  ssize_t read;
+  while (size < ACCESS_POINT_ENTRY_SIZE && (read = file.Read(entry + size, ACCESS_POINT_ENTRY_SIZE - size)) > 0)
+    size += read;
+
+  if (size != ACCESS_POINT_ENTRY_SIZE)
+    return false;
+
+  // each entry is a 64 bit big endian file offset followed by a 64 bit big endian PTS
+  pts = 0;
+  for (int i = 8; i < ACCESS_POINT_ENTRY_SIZE; i++)
+    pts = (pts << 8) | entry[i];
+
+  // most likely an error page instead of an access points file
+  return pts <= PTS_MASK;
+}
+
+void RecordingReader::LoadAccessPoints()
+{
+  // Enigma2 stores the access points next to the recording as <recording>.ap
+  const std::string accessPointsURL = m_streamURL + ".ap";
+
+  kodi::vfs::CFile accessPointsFile;
+  if (!accessPointsFile.CURLCreate(accessPointsURL) || !accessPointsFile.CURLOpen(ADDON_READ_NO_CACHE))
+  {
+    Logger::Log(LEVEL_DEBUG, "%s RecordingReader: No access points available", __func__);
+    return;
+  }
+
+  // only the first and the last keyframe are needed, so skip everything in between
+  const int64_t length = accessPointsFile.GetLength();
+  uint64_t firstPts = 0;
+  uint64_t lastPts = 0;
+  if (length < ACCESS_POINT_ENTRY_SIZE || length % ACCESS_POINT_ENTRY_SIZE != 0 ||
+      !ReadAccessPointPts(accessPointsFile, 0, firstPts) ||
+      !ReadAccessPointPts(accessPointsFile, length - ACCESS_POINT_ENTRY_SIZE, lastPts))
+  {
+    Logger::Log(LEVEL_DEBUG, "%s RecordingReader: No valid access points file found", __func__);
+    return;
+  }
+
+  // masking handles the 33 bit wrap of the PTS
+  m_accessPointsDuration = static_cast<int>(((lastPts - firstPts) & PTS_MASK) / 90000);
+
+  Logger::Log(LEVEL_DEBUG, "%s RecordingReader: Loaded %lld access points, first PTS %lld, duration %d", __func__,
+              static_cast<long long>(length / ACCESS_POINT_ENTRY_SIZE), static_cast<long long>(firstPts), m_accessPointsDuration.load());
+}
+
 int64_t RecordingReader::Seek(long long position, int whence)
 {
-  int64_t ret = m_readHandle.Seek(position, whence);
-  // for unknown reason seek sometimes doesn't return the correct position
-  // so let's sync with the underlaying implementation
-  m_pos = m_readHandle.GetPosition();
-  m_len = m_readHandle.GetLength();
-  return ret;
+  if (m_cache.empty())
+  {
+    int64_t ret = m_readHandle.Seek(position, whence);
+    // for unknown reason seek sometimes doesn't return the correct position
+    // so let's sync with the underlaying implementation
+    m_pos = m_handlePos = m_readHandle.GetPosition();
+    m_len = m_readHandle.GetLength();
+    return ret;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  int64_t target;
+  switch (whence)
+  {
+    case SEEK_SET:
+      target = position;
+      break;
+    case SEEK_CUR:
+      target = m_pos + position;
+      break;
+    case SEEK_END:
+      target = Length() + position;
+      break;
+    default:
+      return -1;
+  }
+
+  if (target < 0)
+    return -1;
+
+  /* seeks within the cached window are free, anything else restarts the read ahead at the new position */
+  if (static_cast<uint64_t>(target) < m_cacheStart || static_cast<uint64_t>(target) > m_cacheEnd)
+  {
+    m_cacheStart = m_cacheEnd = target;
+    m_cacheEof = false;
+    m_cacheGeneration++;
+    m_condition.notify_all();
+  }
+
+  m_pos = target;
+
+  return m_pos;
 }
 
 int64_t RecordingReader::Position()
 {
+  if (m_cache.empty())
+    return m_pos;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
   return m_pos;
 }
 
 int64_t RecordingReader::Length()
 {
-  return m_len;
+  // an ongoing recording may have grown past what the read handle knows about
+  return std::max(m_len.load(), m_followLen.load());
 }
 
 int RecordingReader::CurrentDuration()
@@ -104,6 +399,14 @@ int RecordingReader::CurrentDuration()
     }
   }
 
+  // the time of the last keyframe is closer to the real length than the duration of the recording entry
+  int duration = m_accessPointsDuration;
+  if (duration > 0)
+  {
+    Logger::Log(LEVEL_DEBUG, "%s RecordingReader - Full (access points): %d", __func__, duration);
+    return duration;
+  }
+
   Logger::Log(LEVEL_DEBUG, "%s RecordingReader - Full: %d", __func__, m_duration);
   return m_duration;
 }
@@ -7,8 +7,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <ctime>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <kodi/Filesystem.h>
 
@@ -17,7 +22,7 @@ namespace enigma2
   class ATTR_DLL_LOCAL RecordingReader
   {
   public:
-    RecordingReader(const std::string& streamURL, std::time_t start, std::time_t end, int duration);
+    RecordingReader(const std::string& streamURL, std::time_t start, std::time_t end, int duration, uint64_t readAheadSize);
     ~RecordingReader();
 
     bool Start();
@@ -27,22 +32,58 @@ namespace enigma2
     int64_t Length();
     int CurrentDuration();
 
-
   private:
-    static const int REOPEN_INTERVAL = 30;
-    static const int REOPEN_INTERVAL_FAST = 10;
+    void LoadAccessPoints();
+    static bool ReadAccessPointPts(kodi::vfs::CFile& file, int64_t position, uint64_t& pts);
+    ssize_t ReadFromHandle(unsigned char* buffer, unsigned int size);
+    void DoReadAhead();
+    void DoFollow();
+
+    static const int FOLLOW_PROBE_INTERVAL_MIN = 2;
+    static const int FOLLOW_PROBE_INTERVAL_MAX = 30;
+    // aim to probe about every time this much new data has been recorded
+    static const uint64_t FOLLOW_PROBE_BYTES = 8 * 1024 * 1024;
+    static const int ACCESS_POINT_ENTRY_SIZE = 16;
+    static const uint64_t PTS_MASK = 0x1FFFFFFFFULL;
+    static const int READ_AHEAD_BLOCK_SIZE = 256 * 1024;
+    static const int READ_AHEAD_TIMEOUT = 30;
+    static const int READ_AHEAD_RETRY_WAITTIME = 1000;
 
-    const std::string& m_streamURL;
+    const std::string m_streamURL;
     kodi::vfs::CFile m_readHandle;
 
     int m_duration;
 
     /*!< @brief start and end time of the recording set only in case this an ongoing recording */
     std::time_t m_start;
-    std::time_t m_end;
+    std::atomic<std::time_t> m_end;
 
-    std::time_t m_nextReopen;
     uint64_t m_pos = {0};
-    uint64_t m_len;
+    std::atomic<uint64_t> m_len;
+
+    /*!< @brief length of an ongoing recording as last seen by the follow thread, the read ahead thread only reopens the read handle once it grows past m_len */
+    std::atomic<uint64_t> m_followLen = {0};
+    std::thread m_followThread;
+    std::condition_variable m_followCondition;
+    std::mutex m_followMutex;
+
+    /*!< @brief position of the read handle, only differs from m_pos when reading ahead */
+    uint64_t m_handlePos = 0;
+
+    /*!< @brief ring holding the window of the recording from m_cacheStart to m_cacheEnd, filled ahead of m_pos by the read ahead thread */
+    std::vector<uint8_t> m_cache;
+    uint64_t m_cacheStart = 0;
+    uint64_t m_cacheEnd = 0;
+    bool m_cacheEof = false;
+    unsigned int m_cacheGeneration = 0;
+
+    std::atomic<bool> m_running = {false};
+    std::thread m_readAheadThread;
+    std::condition_variable m_condition;
+    std::mutex m_mutex;
+
+    /*!< @brief time from the first to the last keyframe of a finished recording in seconds, from the Enigma2 access point (.ap) file */
+    std::atomic<int> m_accessPointsDuration = {0};
+    std::thread m_accessPointsThread;
   };
 } // namespace enigma2
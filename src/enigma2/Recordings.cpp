@@ -11,6 +11,8 @@
 #include "utilities/Logger.h"
 #include "utilities/WebUtils.h"
 #include "utilities/XMLUtils.h"
+#include "utilities/XmlFields.h"
+#include "utilities/XmlStreamReader.h"
 
 #include <algorithm>
 #include <chrono>
@@ -81,7 +83,8 @@ void Recordings::GetRecordingEdl(const std::string& recordingId, std::vector<kod
 
   if (!recordingEntry.GetEdlURL().empty())
   {
-    const std::string edlFile = WebUtils::GetHttp(recordingEntry.GetEdlURL());
+    std::string edlFile = WebUtils::GetHttp(recordingEntry.GetEdlURL());
+    StringUtils::TrimRight(edlFile);
 
     if (!StringUtils::EndsWith(edlFile, FILE_NOT_FOUND_RESPONSE_SUFFIX))
     {
@@ -812,56 +815,47 @@ bool Recordings::GetRecordingsFromLocation(const std::string recordingLocation,
     directory = recordingLocation;
   }
 
-  const std::string strXML = WebUtils::GetHttpXML(url);
-
-  TiXmlDocument xmlDoc;
-  if (!xmlDoc.Parse(strXML.c_str()))
-  {
-    Logger::Log(LEVEL_ERROR, "%s Unable to parse XML: %s at line %d", __func__, xmlDoc.ErrorDesc(), xmlDoc.ErrorRow());
-    return false;
-  }
-
-  TiXmlHandle hDoc(&xmlDoc);
+  int iNumRecordings = 0;
 
-  TiXmlElement* pElem = hDoc.FirstChildElement("e2movielist").Element();
+  XmlFields recordingFields(RecordingEntry::GetXmlFieldTable());
 
-  if (!pElem)
-  {
-    Logger::Log(LEVEL_ERROR, "%s Could not find <e2movielist> element!", __func__);
-    return false;
-  }
+  XmlStreamReader xmlReader("e2movielist", "e2movie", [&](std::string_view element) {
+    recordingFields.Read(element);
 
-  TiXmlHandle hRoot = TiXmlHandle(pElem);
+    RecordingEntry recordingEntry{m_settings};
 
-  TiXmlElement* pNode = hRoot.FirstChildElement("e2movie").Element();
+    if (!recordingEntry.UpdateFrom(recordingFields, directory, deleted, m_channels))
+      return true;
 
-  int iNumRecordings = 0;
+    if (m_entryExtractor.IsEnabled())
+      m_entryExtractor.ExtractFromEntry(recordingEntry);
 
-  if (!pNode)
-  {
-    Logger::Log(LEVEL_DEBUG, "%s Could not find <e2movie> element, no movies at location: %s", __func__, directory.c_str());
-  }
-  else
-  {
-    for (; pNode != nullptr; pNode = pNode->NextSiblingElement("e2movie"))
-    {
-      RecordingEntry recordingEntry{m_settings};
+    iNumRecordings++;
 
-      if (!recordingEntry.UpdateFrom(pNode, directory, deleted, m_channels))
-        continue;
+    recordings.emplace_back(recordingEntry);
+    recordingsIdMap.insert({recordingEntry.GetRecordingId(), recordingEntry});
 
-      if (m_entryExtractor.IsEnabled())
-        m_entryExtractor.ExtractFromEntry(recordingEntry);
+    Logger::Log(LEVEL_DEBUG, "%s loaded Recording entry '%s', start '%d', length '%d'", "GetRecordingsFromLocation", recordingEntry.GetTitle().c_str(), recordingEntry.GetStartTime(), recordingEntry.GetDuration());
 
-      iNumRecordings++;
+    return true;
+  });
 
-      recordings.emplace_back(recordingEntry);
-      recordingsIdMap.insert({recordingEntry.GetRecordingId(), recordingEntry});
+  if (!WebUtils::GetHttpStream(url, [&](const char* data, size_t size) { return xmlReader.AddData(data, size); }))
+  {
+    Logger::Log(LEVEL_ERROR, "%s Unable to load recordings from folder '%s'", __func__, recordingLocation.c_str());
+    return false;
+  }
 
-      Logger::Log(LEVEL_DEBUG, "%s loaded Recording entry '%s', start '%d', length '%d'", __func__, recordingEntry.GetTitle().c_str(), recordingEntry.GetStartTime(), recordingEntry.GetDuration());
-    }
+  if (!xmlReader.FoundListElement())
+  {
+    Logger::Log(LEVEL_ERROR, "%s Could not find <e2movielist> element!", __func__);
+    return false;
+  }
 
+  if (xmlReader.GetElementCount() == 0)
+    Logger::Log(LEVEL_DEBUG, "%s Could not find <e2movie> element, no movies at location: %s", __func__, directory.c_str());
+  else
     Logger::Log(LEVEL_INFO, "%s Loaded %u Recording Entries from folder '%s'", __func__, iNumRecordings, recordingLocation.c_str());
-  }
+
   return true;
 }
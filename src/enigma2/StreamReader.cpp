@@ -61,6 +61,11 @@ std::time_t StreamReader::TimeEnd()
   return std::time(nullptr);
 }
 
+int64_t StreamReader::DurationMs()
+{
+  return (TimeEnd() - TimeStart()) * 1000;
+}
+
 bool StreamReader::IsRealTime()
 {
   return true;
@@ -28,6 +28,7 @@ namespace enigma2
     int64_t Length() override;
     std::time_t TimeStart() override;
     std::time_t TimeEnd() override;
+    int64_t DurationMs() override;
     bool IsRealTime() override;
     bool IsTimeshifting() override;
     bool HasTimeshiftCapacity() override;
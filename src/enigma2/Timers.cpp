@@ -12,8 +12,11 @@
 #include "utilities/UpdateState.h"
 #include "utilities/WebUtils.h"
 #include "utilities/XMLUtils.h"
+#include "utilities/XmlFields.h"
+#include "utilities/XmlStreamReader.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cinttypes>
 #include <cstdlib>
 #include <regex>
@@ -37,45 +40,20 @@ T* Timers::GetTimer(std::function<bool(const T&)> func, std::vector<T>& timerlis
   return nullptr;
 }
 
-bool Timers::LoadTimers(std::vector<Timer>& timers) const
+bool Timers::LoadTimers(std::vector<Timer>& timers, bool& unchanged) const
 {
   const std::string url = StringUtils::Format("%s%s", m_settings->GetConnectionURL().c_str(), "web/timerlist");
+  const auto started = std::chrono::high_resolution_clock::now();
 
-  const std::string strXML = WebUtils::GetHttpXML(url);
+  XmlFields timerFields(Timer::GetXmlFieldTable());
 
-  TiXmlDocument xmlDoc;
-  if (!xmlDoc.Parse(strXML.c_str()))
-  {
-    Logger::Log(LEVEL_ERROR, "%s Unable to parse XML: %s at line %d", __func__, xmlDoc.ErrorDesc(), xmlDoc.ErrorRow());
-    return false;
-  }
-
-  TiXmlHandle hDoc(&xmlDoc);
-
-  TiXmlElement* pElem = hDoc.FirstChildElement("e2timerlist").Element();
-
-  if (!pElem)
-  {
-    Logger::Log(LEVEL_ERROR, "%s Could not find <e2timerlist> element!", __func__);
-    return false;
-  }
-
-  TiXmlHandle hRoot = TiXmlHandle(pElem);
-
-  TiXmlElement* pNode = hRoot.FirstChildElement("e2timer").Element();
-
-  if (!pNode)
-  {
-    Logger::Log(LEVEL_ERROR, "%s Could not find <e2timer> element", __func__);
-    return true; //No timers is valid
-  }
+  XmlStreamReader xmlReader("e2timerlist", "e2timer", [&](std::string_view element) {
+    timerFields.Read(element);
 
-  for (; pNode != nullptr; pNode = pNode->NextSiblingElement("e2timer"))
-  {
     Timer newTimer{m_settings};
 
-    if (!newTimer.UpdateFrom(pNode, m_channels))
-      continue;
+    if (!newTimer.UpdateFrom(timerFields, m_channels))
+      return true;
 
     if (m_entryExtractor.IsEnabled())
       m_entryExtractor.ExtractFromEntry(newTimer);
@@ -89,10 +67,41 @@ bool Timers::LoadTimers(std::vector<Timer>& timers) const
     }
 
     Logger::Log(LEVEL_DEBUG, "%s fetched Timer entry '%s', begin '%lld', end '%lld', start padding mins '%u', end padding mins '%u'",
-                __func__, newTimer.GetTitle().c_str(), static_cast<long long>(newTimer.GetStartTime()), static_cast<long long>(newTimer.GetEndTime()), newTimer.GetPaddingStartMins(), newTimer.GetPaddingEndMins());
+                "LoadTimers", newTimer.GetTitle().c_str(), static_cast<long long>(newTimer.GetStartTime()), static_cast<long long>(newTimer.GetEndTime()), newTimer.GetPaddingStartMins(), newTimer.GetPaddingEndMins());
+
+    return true;
+  });
+
+  std::string response;
+  if (!WebUtils::GetHttpXMLIfChanged(url, m_timerListResponse, response, unchanged))
+  {
+    Logger::Log(LEVEL_ERROR, "%s Unable to load timers", __func__);
+    return false;
+  }
+
+  if (unchanged)
+  {
+    Logger::Log(LEVEL_DEBUG, "%s Timer list unchanged", __func__);
+    return true;
+  }
+
+  xmlReader.AddData(response.data(), response.size());
+
+  if (!xmlReader.FoundListElement())
+  {
+    Logger::Log(LEVEL_ERROR, "%s Could not find <e2timerlist> element!", __func__);
+    return false;
+  }
+
+  if (xmlReader.GetElementCount() == 0)
+  {
+    Logger::Log(LEVEL_ERROR, "%s Could not find <e2timer> element", __func__);
+    return true; //No timers is valid
   }
 
-  Logger::Log(LEVEL_INFO, "%s fetched %u Timer Entries", __func__, timers.size());
+  int milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - started).count();
+
+  Logger::Log(LEVEL_INFO, "%s fetched %u Timer Entries - %d (ms)", __func__, timers.size(), milliseconds);
   return true;
 }
 
@@ -171,11 +180,23 @@ std::string Timers::ConvertToAutoTimerTag(std::string tag)
   return std::regex_replace(tag, regex, replaceWith);
 }
 
-bool Timers::LoadAutoTimers(std::vector<AutoTimer>& autoTimers) const
+bool Timers::LoadAutoTimers(std::vector<AutoTimer>& autoTimers, bool& unchanged) const
 {
   const std::string url = StringUtils::Format("%s%s", m_settings->GetConnectionURL().c_str(), "autotimer");
+  const auto started = std::chrono::high_resolution_clock::now();
 
-  const std::string strXML = WebUtils::GetHttpXML(url);
+  std::string strXML;
+  if (!WebUtils::GetHttpXMLIfChanged(url, m_autoTimerListResponse, strXML, unchanged))
+  {
+    Logger::Log(LEVEL_ERROR, "%s Unable to load auto timers", __func__);
+    return false;
+  }
+
+  if (unchanged)
+  {
+    Logger::Log(LEVEL_DEBUG, "%s Auto timer list unchanged", __func__);
+    return true;
+  }
 
   TiXmlDocument xmlDoc;
   if (!xmlDoc.Parse(strXML.c_str()))
@@ -216,7 +237,9 @@ bool Timers::LoadAutoTimers(std::vector<AutoTimer>& autoTimers) const
     Logger::Log(LEVEL_DEBUG, "%s fetched AutoTimer entry '%s', begin '%lld', end '%lld'", __func__, newAutoTimer.GetTitle().c_str(), static_cast<long long>(newAutoTimer.GetStartTime()), static_cast<long long>(newAutoTimer.GetEndTime()));
   }
 
-  Logger::Log(LEVEL_INFO, "%s fetched %u AutoTimer Entries", __func__, autoTimers.size());
+  int milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - started).count();
+
+  Logger::Log(LEVEL_INFO, "%s fetched %u AutoTimer Entries - %d (ms)", __func__, autoTimers.size(), milliseconds);
   return true;
 }
 
@@ -1087,6 +1110,13 @@ void Timers::ClearTimers()
     m_timers.clear();
     m_autotimers.clear();
     m_timerChangeWatchers.clear();
+    ClearCachedResponses();
+}
+
+void Timers::ClearCachedResponses()
+{
+  m_timerListResponse.Clear();
+  m_autoTimerListResponse.Clear();
 }
 
 void Timers::AddTimerChangeWatcher(std::atomic_bool* watcher)
@@ -1119,13 +1149,17 @@ bool Timers::TimerUpdates()
 bool Timers::TimerUpdatesRegular()
 {
   std::vector<Timer> newTimers;
+  bool unchanged = false;
 
-  if (!LoadTimers(newTimers))
+  if (!LoadTimers(newTimers, unchanged))
   {
     Logger::Log(LEVEL_ERROR, "%s Unable to load timers, skipping timer update", __func__);
     return false;
   }
 
+  if (unchanged)
+    return false;
+
   for (auto& timer : m_timers)
   {
     timer.SetUpdateState(UPDATE_STATE_NONE);
@@ -1218,13 +1252,21 @@ bool Timers::TimerUpdatesRegular()
 bool Timers::TimerUpdatesAuto()
 {
   std::vector<AutoTimer> newAutotimers;
+  bool unchanged = false;
 
-  if (!LoadAutoTimers(newAutotimers))
+  if (!LoadAutoTimers(newAutotimers, unchanged))
   {
     Logger::Log(LEVEL_ERROR, "%s Unable to load auto timers, skipping auto timer update", __func__);
     return false;
   }
 
+  if (unchanged)
+  {
+    // The regular timers may still have changed
+    LinkChildTimersToAutoTimers();
+    return false;
+  }
+
   for (auto& autoTimer : m_autotimers)
   {
     autoTimer.SetUpdateState(UPDATE_STATE_NONE);
@@ -1287,6 +1329,15 @@ bool Timers::TimerUpdatesAuto()
     }
   }
 
+  LinkChildTimersToAutoTimers();
+
+  Logger::Log(LEVEL_DEBUG, "%s No of autotimers: removed [%d], untouched [%d], updated '%d', new '%d'", __func__, iRemoved, iUnchanged, iUpdated, iNew);
+
+  return (iRemoved != 0 || iUpdated != 0 || iNew != 0);
+}
+
+void Timers::LinkChildTimersToAutoTimers()
+{
   //Link Any child timers to autotimers
   for (const auto& autoTimer : m_autotimers)
   {
@@ -1301,10 +1352,6 @@ bool Timers::TimerUpdatesAuto()
       }
     }
   }
-
-  Logger::Log(LEVEL_DEBUG, "%s No of autotimers: removed [%d], untouched [%d], updated '%d', new '%d'", __func__, iRemoved, iUnchanged, iUpdated, iNew);
-
-  return (iRemoved != 0 || iUpdated != 0 || iNew != 0);
 }
 
 void Timers::RunAutoTimerListCleanup()
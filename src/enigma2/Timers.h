@@ -11,6 +11,7 @@
 #include "data/AutoTimer.h"
 #include "data/Timer.h"
 #include "extract/EpgEntryExtractor.h"
+#include "utilities/WebUtils.h"
 
 #include <atomic>
 #include <ctime>
@@ -55,6 +56,7 @@ namespace enigma2
     PVR_ERROR DeleteAutoTimer(const kodi::addon::PVRTimer& timer);
 
     void ClearTimers();
+    void ClearCachedResponses();
     bool TimerUpdates();
     void RunAutoTimerListCleanup();
     void AddTimerChangeWatcher(std::atomic_bool* watcher);
@@ -65,14 +67,15 @@ namespace enigma2
     T* GetTimer(std::function<bool(const T&)> func, std::vector<T>& timerlist);
 
     // functions
-    bool LoadTimers(std::vector<enigma2::data::Timer>& timers) const;
+    bool LoadTimers(std::vector<enigma2::data::Timer>& timers, bool& unchanged) const;
     void GenerateChildManualRepeatingTimers(std::vector<enigma2::data::Timer>* timers, enigma2::data::Timer* timer) const;
     static std::string ConvertToAutoTimerTag(std::string tag);
     static std::string RemovePaddingTag(std::string tag);
-    bool LoadAutoTimers(std::vector<enigma2::data::AutoTimer>& autoTimers) const;
+    bool LoadAutoTimers(std::vector<enigma2::data::AutoTimer>& autoTimers, bool& unchanged) const;
     bool IsAutoTimer(const kodi::addon::PVRTimer& timer) const;
     bool TimerUpdatesRegular();
     bool TimerUpdatesAuto();
+    void LinkChildTimersToAutoTimers();
     std::string BuildAddUpdateAutoTimerLimitGroupsParams(const std::shared_ptr<data::Channel>& channel);
     static std::string BuildAddUpdateAutoTimerIncludeParams(int weekdays);
 
@@ -85,6 +88,10 @@ namespace enigma2
     std::vector<enigma2::data::Timer> m_timers;
     std::vector<enigma2::data::AutoTimer> m_autotimers;
 
+    // the last timer lists, parsing is skipped while they do not change
+    mutable utilities::CachedResponse m_timerListResponse;
+    mutable utilities::CachedResponse m_autoTimerListResponse;
+
     IConnectionListener& m_connectionListener;
     Channels& m_channels;
     ChannelGroups& m_channelGroups;
@@ -9,101 +9,193 @@
 
 #include "InstanceSettings.h"
 #include "StreamReader.h"
+#include "TimeshiftFileStorage.h"
+#include "TimeshiftSegmentStorage.h"
 #include "utilities/Logger.h"
 
+#include <algorithm>
+
 using namespace enigma2;
 using namespace enigma2::utilities;
 
 TimeshiftBuffer::TimeshiftBuffer(IStreamReader* streamReader, std::shared_ptr<InstanceSettings>& settings) : m_streamReader(streamReader)
 {
+  std::string bufferPath = ADDON_DATA_BASE_DIR;
   if (kodi::vfs::DirectoryExists(settings->GetTimeshiftBufferPath()))
-    m_bufferFile = settings->GetTimeshiftBufferPath() + "/tsbuffer.ts";
-  else
-    m_bufferFile = ADDON_DATA_BASE_DIR + "/tsbuffer.ts";
+    bufferPath = settings->GetTimeshiftBufferPath();
 
   unsigned int readTimeout = settings->GetReadTimeoutSecs();
   m_readTimeout = (readTimeout) ? readTimeout : DEFAULT_READ_TIMEOUT;
   if (settings->EnableTimeshiftDiskLimit())
+  {
     m_timeshiftBufferByteLimit = settings->GetTimeshiftDiskLimitBytes();
+    m_wrapAround = settings->GetTimeshiftDiskLimitMode() == TimeshiftDiskLimitMode::WRAP_AROUND && m_timeshiftBufferByteLimit > 0;
+  }
 
-  m_filebufferWriteHandle.OpenFileForWrite(m_bufferFile, true);
-  std::this_thread::sleep_for(std::chrono::milliseconds(100));
-  m_filebufferReadHandle.OpenFile(m_bufferFile, ADDON_READ_NO_CACHE);
+  if (settings->UseTimeshiftSegmentFiles())
+    m_storage.reset(new TimeshiftSegmentStorage(bufferPath, m_timeshiftBufferByteLimit, m_wrapAround));
+  else
+    m_storage.reset(new TimeshiftFileStorage(bufferPath, m_timeshiftBufferByteLimit, m_wrapAround));
+
+  for (int i = 0; i < WRITE_BUFFER_COUNT; i++)
+  {
+    WriteBuffer writeBuffer;
+    writeBuffer.m_data.reset(new uint8_t[WRITE_BUFFER_SIZE]);
+    m_freeWriteBuffers.emplace_back(std::move(writeBuffer));
+  }
 }
 
 TimeshiftBuffer::~TimeshiftBuffer()
 {
   m_running = false;
+  {
+    std::lock_guard<std::mutex> lock(m_writeQueueMutex);
+    m_writeQueueCondition.notify_all();
+  }
   if (m_inputThread.joinable())
     m_inputThread.join();
+  if (m_writerThread.joinable())
+    m_writerThread.join();
 
-  if (m_filebufferWriteHandle.IsOpen())
-  {
-    // XBMC->TruncateFile doesn't work for unknown reasons
-    m_filebufferWriteHandle.Close();
-    kodi::vfs::CFile tmp;
-    if (tmp.OpenFileForWrite(m_bufferFile, true))
-      tmp.Close();
-  }
-  if (m_filebufferReadHandle.IsOpen())
-    m_filebufferReadHandle.Close();
+  m_storage.reset();
 
-  if (!kodi::vfs::DeleteFile(m_bufferFile))
-    Logger::Log(LEVEL_ERROR, "%s Unable to delete file when timeshift buffer is deleted: %s", __func__, m_bufferFile.c_str());
+  Logger::Log(LEVEL_DEBUG, "%s Timeshift: Write queue - max depth: %zu, late buffers: %u, dropped buffers: %u", __func__,
+              m_maxWriteQueueDepth, m_lateWriteBuffers, m_droppedWriteBuffers);
 
   Logger::Log(LEVEL_DEBUG, "%s Timeshift: Stopped", __func__);
 }
 
 bool TimeshiftBuffer::Start()
 {
-  if (m_streamReader == nullptr || !m_filebufferWriteHandle.IsOpen() || !m_filebufferReadHandle.IsOpen())
+  if (m_streamReader == nullptr || !m_storage->IsOpen())
     return false;
   if (m_running)
     return true;
 
-  Logger::Log(LEVEL_INFO, "%s Timeshift: Started", __func__);
+  Logger::Log(LEVEL_INFO, "%s Timeshift: Started%s", __func__, m_wrapAround ? " - wrapping around at disk limit" : "");
   m_start = std::time(nullptr);
   m_running = true;
-  m_inputThread = std::thread([&] { DoReadWrite(); });
+  m_writerThread = std::thread([&] { DoWrite(); });
+  m_inputThread = std::thread([&] { DoRead(); });
 
   return true;
 }
 
-void TimeshiftBuffer::DoReadWrite()
+void TimeshiftBuffer::DoRead()
 {
-  Logger::Log(LEVEL_DEBUG, "%s Timeshift: Thread started", __func__);
-  uint8_t buffer[BUFFER_SIZE];
+  Logger::Log(LEVEL_DEBUG, "%s Timeshift: Read thread started", __func__);
+
+  WriteBuffer buffer;
+  {
+    std::lock_guard<std::mutex> lock(m_writeQueueMutex);
+    buffer = std::move(m_freeWriteBuffers.front());
+    m_freeWriteBuffers.pop_front();
+  }
 
   m_streamReader->Start();
   while (m_running)
   {
-    ssize_t read = m_streamReader->ReadData(buffer, sizeof(buffer));
+    size_t readSize = std::min<size_t>(BUFFER_SIZE, WRITE_BUFFER_SIZE - buffer.m_size);
+    ssize_t read = m_streamReader->ReadData(buffer.m_data.get() + buffer.m_size, readSize);
 
-    // don't handle any errors here, assume write fully succeeds
-    ssize_t write = m_filebufferWriteHandle.Write(buffer, read);
+    if (read > 0)
+      buffer.m_size += read;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_writePos += write;
+    if (buffer.m_size == 0)
+      continue;
 
-    m_condition.notify_one();
+    std::unique_lock<std::mutex> lock(m_writeQueueMutex);
+
+    // keep filling the buffer while the writer is busy so it gets fewer but larger writes
+    if (buffer.m_size < WRITE_BUFFER_SIZE && !m_filledWriteBuffers.empty())
+      continue;
+
+    if (m_freeWriteBuffers.empty())
+    {
+      // never block the stream for long, rather lose data than stall the receiver
+      bool available = m_writeQueueCondition.wait_for(lock, std::chrono::milliseconds(WRITE_BUFFER_WAIT_MS),
+                                                      [&] { return !m_freeWriteBuffers.empty() || !m_running; });
+      if (!m_running)
+        break;
+
+      if (!available)
+      {
+        m_droppedWriteBuffers++;
+        Logger::Log(LEVEL_WARNING, "%s Timeshift: Storage too slow, dropped %zu bytes of stream data", __func__, buffer.m_size);
+        buffer.m_size = 0;
+        continue;
+      }
+
+      m_lateWriteBuffers++;
+    }
+
+    m_filledWriteBuffers.emplace_back(std::move(buffer));
+    m_maxWriteQueueDepth = std::max(m_maxWriteQueueDepth, m_filledWriteBuffers.size());
+
+    buffer = std::move(m_freeWriteBuffers.front());
+    m_freeWriteBuffers.pop_front();
+    buffer.m_size = 0;
+
+    m_writeQueueCondition.notify_all();
   }
-  Logger::Log(LEVEL_DEBUG, "%s Timeshift: Thread stopped", __func__);
-  return;
-}
 
-int64_t TimeshiftBuffer::Seek(long long position, int whence)
-{
-  return m_filebufferReadHandle.Seek(position, whence);
+  std::lock_guard<std::mutex> lock(m_writeQueueMutex);
+  m_freeWriteBuffers.emplace_back(std::move(buffer));
+
+  Logger::Log(LEVEL_DEBUG, "%s Timeshift: Read thread stopped", __func__);
 }
 
-int64_t TimeshiftBuffer::Position()
+void TimeshiftBuffer::DoWrite()
 {
-  return m_filebufferReadHandle.GetPosition();
+  Logger::Log(LEVEL_DEBUG, "%s Timeshift: Write thread started", __func__);
+
+  while (true)
+  {
+    WriteBuffer buffer;
+    {
+      std::unique_lock<std::mutex> lock(m_writeQueueMutex);
+      m_writeQueueCondition.wait(lock, [&] { return !m_filledWriteBuffers.empty() || !m_running; });
+
+      if (!m_running)
+        break;
+
+      buffer = std::move(m_filledWriteBuffers.front());
+      m_filledWriteBuffers.pop_front();
+    }
+
+    WriteToBuffer(buffer.m_data.get(), buffer.m_size);
+
+    std::lock_guard<std::mutex> lock(m_writeQueueMutex);
+    buffer.m_size = 0;
+    m_freeWriteBuffers.emplace_back(std::move(buffer));
+    m_writeQueueCondition.notify_all();
+  }
+
+  Logger::Log(LEVEL_DEBUG, "%s Timeshift: Write thread stopped", __func__);
 }
 
-int64_t TimeshiftBuffer::Length()
+void TimeshiftBuffer::WriteToBuffer(const uint8_t* buffer, size_t size)
 {
-  return m_writePos;
+  while (size > 0)
+  {
+    // don't handle any errors here, assume write fully succeeds
+    ssize_t write = m_storage->Write(buffer, size);
+    if (write <= 0)
+      return;
+
+    m_index.AddData(buffer, write);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_writePos += write;
+
+    if (m_wrapAround)
+      AddWriteTime(m_writePos);
+
+    m_condition.notify_one();
+
+    buffer += write;
+    size -= write;
+  }
 }
 
 ssize_t TimeshiftBuffer::ReadData(unsigned char* buffer, unsigned int size)
@@ -120,32 +212,37 @@ ssize_t TimeshiftBuffer::ReadData(unsigned char* buffer, unsigned int size)
     return -1;
   }
 
-  return m_filebufferReadHandle.Read(buffer, size);
-}
+  /* the oldest data may have been overwritten while we were paused */
+  uint64_t readableStartPos = GetReadableStartPosition();
+  if (m_readPos < readableStartPos)
+  {
+    Logger::Log(LEVEL_DEBUG, "%s Timeshift: Read position %lld was overwritten, skipping to %lld", __func__,
+                static_cast<long long>(m_readPos), static_cast<long long>(readableStartPos));
+    m_readPos = readableStartPos;
+  }
 
-std::time_t TimeshiftBuffer::TimeStart()
-{
-  return m_start;
-}
+  lock.unlock();
 
-std::time_t TimeshiftBuffer::TimeEnd()
-{
-  return std::time(nullptr);
-}
+  ssize_t totalRead = 0;
+  while (totalRead < static_cast<ssize_t>(size))
+  {
+    ssize_t read = m_storage->Read(m_readPos, buffer + totalRead, size - totalRead);
+    if (read <= 0)
+      break;
 
-bool TimeshiftBuffer::IsRealTime()
-{
-  // other PVRs use 10 seconds here, but we aren't doing any demuxing
-  // we'll therefore just asume 1 secs needs about 1mb
-  return Length() - Position() <= 10 * 1048576;
+    m_readPos += read;
+    totalRead += read;
+  }
+
+  return totalRead;
 }
 
-bool TimeshiftBuffer::IsTimeshifting()
+uint64_t TimeshiftBuffer::GetReadableStartPosition()
 {
-  return true;
+  return m_storage->GetReadableStartPosition();
 }
 
 bool TimeshiftBuffer::HasTimeshiftCapacity()
 {
-  return m_timeshiftBufferByteLimit == 0 || m_timeshiftBufferByteLimit > m_writePos;
+  return m_wrapAround || m_timeshiftBufferByteLimit == 0 || m_timeshiftBufferByteLimit > m_writePos;
 }
@@ -7,11 +7,14 @@
 
 #pragma once
 
-#include "IStreamReader.h"
+#include "ITimeshiftStorage.h"
 #include "InstanceSettings.h"
+#include "TimeshiftBufferBase.h"
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -19,7 +22,7 @@
 
 namespace enigma2
 {
-  class ATTR_DLL_LOCAL TimeshiftBuffer : public IStreamReader
+  class ATTR_DLL_LOCAL TimeshiftBuffer : public TimeshiftBufferBase
   {
   public:
     TimeshiftBuffer(IStreamReader* strReader, std::shared_ptr<enigma2::InstanceSettings>& settings);
@@ -27,34 +30,51 @@ namespace enigma2
 
     bool Start() override;
     ssize_t ReadData(unsigned char* buffer, unsigned int size) override;
-    int64_t Seek(long long position, int whence) override;
-    int64_t Position() override;
-    int64_t Length() override;
-    std::time_t TimeStart() override;
-    std::time_t TimeEnd() override;
-    bool IsRealTime() override;
-    bool IsTimeshifting() override;
     bool HasTimeshiftCapacity() override;
 
+  protected:
+    uint64_t GetReadableStartPosition() override;
+
   private:
-    void DoReadWrite();
+    /**
+     * A block of stream data passed from the network thread to the writer thread
+     */
+    struct WriteBuffer
+    {
+      std::unique_ptr<uint8_t[]> m_data;
+      size_t m_size = 0;
+    };
+
+    void DoRead();
+    void DoWrite();
+    void WriteToBuffer(const uint8_t* buffer, size_t size);
 
     static const int BUFFER_SIZE = 32 * 1024;
     static const int DEFAULT_READ_TIMEOUT = 10;
     static const int READ_WAITTIME = 50;
+    static const int WRITE_BUFFER_SIZE = 1024 * 1024;
+    static const int WRITE_BUFFER_COUNT = 8;
+    static const int WRITE_BUFFER_WAIT_MS = 500;
 
-    std::string m_bufferFile;
     IStreamReader* m_streamReader;
-    kodi::vfs::CFile m_filebufferReadHandle;
-    kodi::vfs::CFile m_filebufferWriteHandle;
+    std::unique_ptr<ITimeshiftStorage> m_storage;
     int m_readTimeout;
-    std::time_t m_start = 0;
-    std::atomic<uint64_t> m_writePos = {0};
     uint64_t m_timeshiftBufferByteLimit = 0LL;
+    bool m_wrapAround = false;
 
     std::atomic<bool> m_running = {false};
     std::thread m_inputThread;
     std::condition_variable m_condition;
     std::mutex m_mutex;
+
+    /*!< @brief buffers free to be filled by the network thread and those waiting to be written to storage */
+    std::deque<WriteBuffer> m_freeWriteBuffers;
+    std::deque<WriteBuffer> m_filledWriteBuffers;
+    std::thread m_writerThread;
+    std::condition_variable m_writeQueueCondition;
+    std::mutex m_writeQueueMutex;
+    size_t m_maxWriteQueueDepth = 0;
+    unsigned int m_lateWriteBuffers = 0;
+    unsigned int m_droppedWriteBuffers = 0;
   };
 } // namespace enigma2
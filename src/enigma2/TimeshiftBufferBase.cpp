@@ -0,0 +1,114 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#include "TimeshiftBufferBase.h"
+
+#include <algorithm>
+
+using namespace enigma2;
+
+int64_t TimeshiftBufferBase::Seek(long long position, int whence)
+{
+  int64_t target;
+  switch (whence)
+  {
+    case SEEK_SET:
+      target = position;
+      break;
+    case SEEK_CUR:
+      target = m_readPos + position;
+      break;
+    case SEEK_END:
+      target = Length() + position;
+      break;
+    default:
+      return -1;
+  }
+
+  // keep the position within the readable window of the buffer
+  target = std::max<int64_t>(target, GetReadableStartPosition());
+  target = std::min<int64_t>(target, Length());
+
+  m_readPos = target;
+
+  return m_readPos;
+}
+
+int64_t TimeshiftBufferBase::Position()
+{
+  return m_readPos;
+}
+
+int64_t TimeshiftBufferBase::Length()
+{
+  return m_writePos;
+}
+
+void TimeshiftBufferBase::AddWriteTime(uint64_t writePos)
+{
+  std::lock_guard<std::mutex> lock(m_writeTimesMutex);
+
+  std::time_t now = std::time(nullptr);
+  if (m_writeTimes.empty() || m_writeTimes.back().first != now)
+    m_writeTimes.emplace_back(now, writePos);
+
+  // only the newest sample before the readable window is required
+  uint64_t readableStartPos = GetReadableStartPosition();
+  while (m_writeTimes.size() > 1 && m_writeTimes[1].second <= readableStartPos)
+    m_writeTimes.pop_front();
+
+  m_index.RemoveBefore(readableStartPos);
+}
+
+std::time_t TimeshiftBufferBase::TimeStart()
+{
+  if (m_index.HasTimes())
+    return TimeEnd() - DurationMs() / 1000;
+
+  std::lock_guard<std::mutex> lock(m_writeTimesMutex);
+  uint64_t readableStartPos = GetReadableStartPosition();
+  if (readableStartPos == 0 || m_writeTimes.empty())
+    return m_start;
+
+  // the first sample at or after the start of the readable window
+  for (const auto& writeTime : m_writeTimes)
+  {
+    if (writeTime.second >= readableStartPos)
+      return writeTime.first;
+  }
+
+  return m_writeTimes.back().first;
+}
+
+std::time_t TimeshiftBufferBase::TimeEnd()
+{
+  return std::time(nullptr);
+}
+
+int64_t TimeshiftBufferBase::DurationMs()
+{
+  // playback of the oldest data can only start at the first keyframe in the window
+  if (m_index.HasTimes())
+    return m_index.GetTimeMs(Length()) - m_index.GetTimeMs(m_index.GetAccessPointAfter(GetReadableStartPosition()));
+
+  return (TimeEnd() - TimeStart()) * 1000;
+}
+
+bool TimeshiftBufferBase::IsRealTime()
+{
+  // other PVRs use 10 seconds here
+  if (m_index.HasTimes())
+    return m_index.GetTimeMs(Length()) - m_index.GetTimeMs(Position()) <= 10 * 1000;
+
+  // without any media times we'll just asume 1 secs needs about 1mb
+  return Length() - Position() <= 10 * 1048576;
+}
+
+bool TimeshiftBufferBase::IsTimeshifting()
+{
+  return true;
+}
@@ -0,0 +1,59 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#pragma once
+
+#include "IStreamReader.h"
+#include "TimeshiftIndex.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace enigma2
+{
+  /**
+   * The read position, seeking and time keeping shared by the timeshift buffers.
+   * Derived buffers store the data, advance the write position and report where
+   * the readable window of the buffer starts.
+   */
+  class ATTR_DLL_LOCAL TimeshiftBufferBase : public IStreamReader
+  {
+  public:
+    int64_t Seek(long long position, int whence) override;
+    int64_t Position() override;
+    int64_t Length() override;
+    std::time_t TimeStart() override;
+    std::time_t TimeEnd() override;
+    int64_t DurationMs() override;
+    bool IsRealTime() override;
+    bool IsTimeshifting() override;
+
+  protected:
+    /**
+     * The position of the oldest data which can still be read
+     */
+    virtual uint64_t GetReadableStartPosition() = 0;
+
+    /**
+     * Records the wall clock time at which the write position was reached and
+     * forgets times and index entries from before the readable window
+     */
+    void AddWriteTime(uint64_t writePos);
+
+    TimeshiftIndex m_index;
+    std::time_t m_start = 0;
+    std::atomic<uint64_t> m_writePos = {0};
+    std::atomic<uint64_t> m_readPos = {0};
+
+  private:
+    /*!< @brief wall clock time at which each write position was reached, used to find the start time of the readable window */
+    std::deque<std::pair<std::time_t, uint64_t>> m_writeTimes;
+    std::mutex m_writeTimesMutex;
+  };
+} // namespace enigma2
@@ -0,0 +1,96 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#include "TimeshiftFileStorage.h"
+
+#include "utilities/Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+using namespace enigma2;
+using namespace enigma2::utilities;
+
+TimeshiftFileStorage::TimeshiftFileStorage(const std::string& bufferPath, uint64_t byteLimit, bool wrapAround)
+  : m_bufferFile(bufferPath + "/tsbuffer.ts"), m_byteLimit(byteLimit), m_wrapAround(wrapAround && byteLimit > WRAP_AROUND_GUARD_SIZE)
+{
+  m_filebufferWriteHandle.OpenFileForWrite(m_bufferFile, true);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  m_filebufferReadHandle.OpenFile(m_bufferFile, ADDON_READ_NO_CACHE);
+}
+
+TimeshiftFileStorage::~TimeshiftFileStorage()
+{
+  if (m_filebufferWriteHandle.IsOpen())
+  {
+    // XBMC->TruncateFile doesn't work for unknown reasons
+    m_filebufferWriteHandle.Close();
+    kodi::vfs::CFile tmp;
+    if (tmp.OpenFileForWrite(m_bufferFile, true))
+      tmp.Close();
+  }
+  if (m_filebufferReadHandle.IsOpen())
+    m_filebufferReadHandle.Close();
+
+  if (!kodi::vfs::DeleteFile(m_bufferFile))
+    Logger::Log(LEVEL_ERROR, "%s Unable to delete file when timeshift buffer is deleted: %s", __func__, m_bufferFile.c_str());
+}
+
+bool TimeshiftFileStorage::IsOpen()
+{
+  return m_filebufferWriteHandle.IsOpen() && m_filebufferReadHandle.IsOpen();
+}
+
+ssize_t TimeshiftFileStorage::Write(const uint8_t* buffer, size_t size)
+{
+  uint64_t bufferOffset = GetBufferOffset(m_writePos);
+
+  if (m_wrapAround)
+  {
+    // back to the start of the buffer file once the byte limit is reached
+    if (bufferOffset == 0 && m_writePos > 0)
+      m_filebufferWriteHandle.Seek(0, SEEK_SET);
+
+    size = std::min<uint64_t>(size, m_byteLimit - bufferOffset);
+  }
+
+  ssize_t write = m_filebufferWriteHandle.Write(buffer, size);
+  if (write > 0)
+    m_writePos += write;
+
+  return write;
+}
+
+ssize_t TimeshiftFileStorage::Read(uint64_t position, uint8_t* buffer, size_t size)
+{
+  uint64_t bufferOffset = GetBufferOffset(position);
+
+  if (m_filebufferReadHandle.GetPosition() != static_cast<int64_t>(bufferOffset))
+    m_filebufferReadHandle.Seek(bufferOffset, SEEK_SET);
+
+  if (m_wrapAround)
+    size = std::min<uint64_t>(size, m_byteLimit - bufferOffset);
+
+  return m_filebufferReadHandle.Read(buffer, size);
+}
+
+uint64_t TimeshiftFileStorage::GetReadableStartPosition()
+{
+  uint64_t writePos = m_writePos;
+  uint64_t readableSize = m_byteLimit - WRAP_AROUND_GUARD_SIZE;
+
+  if (!m_wrapAround || writePos <= readableSize)
+    return 0;
+
+  return writePos - readableSize;
+}
+
+uint64_t TimeshiftFileStorage::GetBufferOffset(uint64_t position) const
+{
+  return m_wrapAround ? position % m_byteLimit : position;
+}
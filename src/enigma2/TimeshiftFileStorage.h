@@ -0,0 +1,47 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#pragma once
+
+#include "ITimeshiftStorage.h"
+
+#include <atomic>
+#include <string>
+
+#include <kodi/Filesystem.h>
+
+namespace enigma2
+{
+  /**
+   * Stores the timeshift buffer in a single file. When wrapping around the file
+   * is reused from its start once the byte limit is reached.
+   */
+  class ATTR_DLL_LOCAL TimeshiftFileStorage : public ITimeshiftStorage
+  {
+  public:
+    TimeshiftFileStorage(const std::string& bufferPath, uint64_t byteLimit, bool wrapAround);
+    ~TimeshiftFileStorage();
+
+    bool IsOpen() override;
+    ssize_t Write(const uint8_t* buffer, size_t size) override;
+    ssize_t Read(uint64_t position, uint8_t* buffer, size_t size) override;
+    uint64_t GetReadableStartPosition() override;
+
+  private:
+    uint64_t GetBufferOffset(uint64_t position) const;
+
+    // when wrapping around keep this much of the oldest data unreadable so the reader never reads what the writer is overwriting
+    static const int WRAP_AROUND_GUARD_SIZE = 8 * 1024 * 1024;
+
+    std::string m_bufferFile;
+    kodi::vfs::CFile m_filebufferReadHandle;
+    kodi::vfs::CFile m_filebufferWriteHandle;
+    uint64_t m_byteLimit;
+    bool m_wrapAround;
+    std::atomic<uint64_t> m_writePos = {0};
+  };
+} // namespace enigma2
@@ -0,0 +1,308 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#include "TimeshiftIndex.h"
+
+#include "utilities/Logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+using namespace enigma2;
+using namespace enigma2::utilities;
+
+void TimeshiftIndex::AddData(const uint8_t* data, size_t size)
+{
+  size_t offset = 0;
+
+  // complete a packet split over the previous call
+  if (m_packetSize > 0)
+  {
+    offset = std::min<size_t>(TS_PACKET_SIZE - m_packetSize, size);
+    std::memcpy(m_packet + m_packetSize, data, offset);
+    m_packetSize += offset;
+
+    if (m_packetSize < TS_PACKET_SIZE)
+    {
+      m_position += size;
+      return;
+    }
+
+    ParsePacket(m_packet, m_position + offset - TS_PACKET_SIZE);
+    m_packetSize = 0;
+  }
+
+  while (offset < size)
+  {
+    // resync on the next sync byte if we lost packet alignment
+    if (data[offset] != TS_SYNC_BYTE)
+    {
+      offset++;
+      continue;
+    }
+
+    if (size - offset < TS_PACKET_SIZE)
+    {
+      m_packetSize = size - offset;
+      std::memcpy(m_packet, data + offset, m_packetSize);
+      break;
+    }
+
+    ParsePacket(data + offset, m_position + offset);
+    offset += TS_PACKET_SIZE;
+  }
+
+  m_position += size;
+}
+
+void TimeshiftIndex::ParsePacket(const uint8_t* packet, uint64_t position)
+{
+  int pid = ((packet[1] & 0x1F) << 8) | packet[2];
+  bool payloadUnitStart = packet[1] & 0x40;
+  bool hasAdaptationField = packet[3] & 0x20;
+  bool hasPayload = packet[3] & 0x10;
+  uint8_t adaptationFieldLength = hasAdaptationField ? packet[4] : 0;
+  bool randomAccess = adaptationFieldLength > 0 && (packet[5] & 0x40);
+
+  size_t payloadOffset = hasAdaptationField ? 5 + adaptationFieldLength : 4;
+  if (hasPayload && payloadUnitStart && payloadOffset < TS_PACKET_SIZE)
+  {
+    const uint8_t* payload = packet + payloadOffset;
+    size_t payloadSize = TS_PACKET_SIZE - payloadOffset;
+
+    if (pid == 0)
+      ParsePat(payload, payloadSize);
+    else if (pid == m_pmtPid)
+      ParsePmt(payload, payloadSize);
+    else if (pid == m_videoPid && (randomAccess || IsAccessPoint(payload, payloadSize)))
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_accessPoints.push_back(position);
+    }
+  }
+
+  bool hasPcr = adaptationFieldLength > 0 && (packet[5] & 0x10);
+  if (adaptationFieldLength < 7 || !hasPcr)
+    return;
+
+  if (m_pcrPid < 0)
+  {
+    m_pcrPid = pid;
+    Logger::Log(LEVEL_DEBUG, "%s Timeshift: Using PCR from PID %d", __func__, pid);
+  }
+  else if (pid != m_pcrPid)
+  {
+    return;
+  }
+
+  // only the 33 bit base in 90kHz units is required, ignore the 27MHz extension
+  uint64_t pcr = (static_cast<uint64_t>(packet[6]) << 25) | (static_cast<uint64_t>(packet[7]) << 17) |
+                 (static_cast<uint64_t>(packet[8]) << 9) | (static_cast<uint64_t>(packet[9]) << 1) |
+                 (static_cast<uint64_t>(packet[10]) >> 7);
+
+  AddPcr(pcr, position);
+}
+
+void TimeshiftIndex::ParsePat(const uint8_t* payload, size_t size)
+{
+  // PAT and PMT sections are assumed to fit into a single packet which is the case for broadcast streams
+  size_t offset = 1 + payload[0];
+  if (m_pmtPid >= 0 || offset + 8 > size || payload[offset] != 0x00)
+    return;
+
+  const uint8_t* section = payload + offset;
+  size_t sectionEnd = GetSectionEnd(section, size - offset);
+
+  // skip the header, each program entry is 4 bytes
+  for (size_t i = 8; i + 4 <= sectionEnd; i += 4)
+  {
+    int programNumber = (section[i] << 8) | section[i + 1];
+    if (programNumber == 0)
+      continue;
+
+    m_pmtPid = ((section[i + 2] & 0x1F) << 8) | section[i + 3];
+    Logger::Log(LEVEL_DEBUG, "%s Timeshift: Using PMT from PID %d", __func__, m_pmtPid);
+    return;
+  }
+}
+
+void TimeshiftIndex::ParsePmt(const uint8_t* payload, size_t size)
+{
+  size_t offset = 1 + payload[0];
+  if (m_videoPid >= 0 || offset + 12 > size || payload[offset] != 0x02)
+    return;
+
+  const uint8_t* section = payload + offset;
+  size_t sectionEnd = GetSectionEnd(section, size - offset);
+  size_t programInfoLength = ((section[10] & 0x0F) << 8) | section[11];
+
+  // each stream entry is 5 bytes followed by its descriptors
+  for (size_t i = 12 + programInfoLength; i + 5 <= sectionEnd;)
+  {
+    uint8_t streamType = section[i];
+    int pid = ((section[i + 1] & 0x1F) << 8) | section[i + 2];
+    size_t esInfoLength = ((section[i + 3] & 0x0F) << 8) | section[i + 4];
+
+    if (streamType == 0x01 || streamType == 0x02)
+      m_videoCodec = VideoCodec::MPEG2;
+    else if (streamType == 0x1B)
+      m_videoCodec = VideoCodec::H264;
+    else if (streamType == 0x24)
+      m_videoCodec = VideoCodec::HEVC;
+
+    if (m_videoCodec != VideoCodec::UNKNOWN)
+    {
+      m_videoPid = pid;
+      Logger::Log(LEVEL_DEBUG, "%s Timeshift: Indexing access points of video PID %d, stream type 0x%02x", __func__, pid, streamType);
+      return;
+    }
+
+    i += 5 + esInfoLength;
+  }
+}
+
+size_t TimeshiftIndex::GetSectionEnd(const uint8_t* section, size_t size)
+{
+  // the section length counts the bytes after the length field, including the 4 byte CRC
+  size_t sectionEnd = 3 + (((section[1] & 0x0F) << 8) | section[2]);
+  sectionEnd = std::min(sectionEnd, size);
+
+  return sectionEnd > 4 ? sectionEnd - 4 : 0;
+}
+
+bool TimeshiftIndex::IsAccessPoint(const uint8_t* payload, size_t size) const
+{
+  // skip the PES header, the start of the elementary stream must be in this packet
+  if (size < 9 || payload[0] != 0x00 || payload[1] != 0x00 || payload[2] != 0x01)
+    return false;
+
+  size_t offset = 9 + payload[8];
+
+  // look for a start code of a keyframe or of the parameter sets which always precede one
+  for (size_t i = offset; i + 4 < size; i++)
+  {
+    if (payload[i] != 0x00 || payload[i + 1] != 0x00 || payload[i + 2] != 0x01)
+      continue;
+
+    uint8_t code = payload[i + 3];
+    switch (m_videoCodec)
+    {
+      case VideoCodec::MPEG2:
+        // sequence header or group of pictures
+        if (code == 0xB3 || code == 0xB8)
+          return true;
+        break;
+      case VideoCodec::H264:
+      {
+        // IDR slice or sequence parameter set
+        int nalType = code & 0x1F;
+        if (nalType == 5 || nalType == 7)
+          return true;
+        break;
+      }
+      case VideoCodec::HEVC:
+      {
+        // IRAP slice or video/sequence parameter set
+        int nalType = (code >> 1) & 0x3F;
+        if ((nalType >= 16 && nalType <= 21) || nalType == 32 || nalType == 33)
+          return true;
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+
+  return false;
+}
+
+void TimeshiftIndex::AddPcr(uint64_t pcr, uint64_t position)
+{
+  if (m_time < 0)
+  {
+    m_time = 0;
+  }
+  else
+  {
+    // masking handles the 33 bit wrap, a backwards jump ends up as a very large delta
+    int64_t delta = static_cast<int64_t>((pcr - m_lastPcr) & PCR_MASK);
+    if (delta > MAX_PCR_DELTA)
+    {
+      Logger::Log(LEVEL_DEBUG, "%s Timeshift: PCR discontinuity at position %lld", __func__, static_cast<long long>(position));
+      delta = 0;
+    }
+    m_time += delta;
+  }
+  m_lastPcr = pcr;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_latest = {position, m_time};
+  if (m_entries.empty() || m_time - m_entries.back().m_time >= INDEX_INTERVAL)
+    m_entries.push_back(m_latest);
+}
+
+void TimeshiftIndex::RemoveBefore(uint64_t position)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  // keep the newest entry before the position so it can still be interpolated
+  while (m_entries.size() > 1 && m_entries[1].m_position <= position)
+    m_entries.pop_front();
+
+  while (!m_accessPoints.empty() && m_accessPoints.front() < position)
+    m_accessPoints.pop_front();
+}
+
+bool TimeshiftIndex::HasTimes()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return !m_entries.empty();
+}
+
+int64_t TimeshiftIndex::GetTimeMs(uint64_t position)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_entries.empty())
+    return -1;
+
+  auto entryIt = std::upper_bound(m_entries.begin(), m_entries.end(), position,
+                                  [](uint64_t position, const Entry& entry) { return position < entry.m_position; });
+
+  int64_t time;
+  if (entryIt == m_entries.begin())
+    time = entryIt->m_time;
+  else if (entryIt == m_entries.end())
+    time = position >= m_latest.m_position ? m_latest.m_time : Interpolate(m_entries.back(), m_latest, position);
+  else
+    time = Interpolate(*std::prev(entryIt), *entryIt, position);
+
+  return time * 1000 / PCR_CLOCK;
+}
+
+uint64_t TimeshiftIndex::GetAccessPointAfter(uint64_t position)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto accessPointIt = std::lower_bound(m_accessPoints.begin(), m_accessPoints.end(), position);
+  if (accessPointIt == m_accessPoints.end())
+    return position;
+
+  return *accessPointIt;
+}
+
+int64_t TimeshiftIndex::Interpolate(const Entry& previous, const Entry& next, uint64_t position)
+{
+  if (next.m_position <= previous.m_position)
+    return previous.m_time;
+
+  double fraction = static_cast<double>(position - previous.m_position) / (next.m_position - previous.m_position);
+
+  return previous.m_time + static_cast<int64_t>((next.m_time - previous.m_time) * fraction);
+}
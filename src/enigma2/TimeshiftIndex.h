@@ -0,0 +1,89 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+#include <kodi/AddonBase.h>
+
+namespace enigma2
+{
+  /**
+   * Maps positions in a timeshift buffer to media time. The MPEG-TS data is
+   * lightly parsed as it is written and the PCR of the first PID carrying one
+   * is sampled about once a second. Positions in between are interpolated.
+   *
+   * The positions of random access points (packets starting a keyframe) of the
+   * first video stream are kept as well so it is known where decoding can start.
+   */
+  class ATTR_DLL_LOCAL TimeshiftIndex
+  {
+  public:
+    void AddData(const uint8_t* data, size_t size);
+    void RemoveBefore(uint64_t position);
+
+    bool HasTimes();
+    int64_t GetTimeMs(uint64_t position);
+
+    /**
+     * Returns the first access point at or after the position, or the position
+     * itself if no access point is known past it
+     */
+    uint64_t GetAccessPointAfter(uint64_t position);
+
+  private:
+    struct Entry
+    {
+      uint64_t m_position;
+      int64_t m_time;
+    };
+
+    void ParsePacket(const uint8_t* packet, uint64_t position);
+    void ParsePat(const uint8_t* payload, size_t size);
+    void ParsePmt(const uint8_t* payload, size_t size);
+    bool IsAccessPoint(const uint8_t* payload, size_t size) const;
+    static size_t GetSectionEnd(const uint8_t* section, size_t size);
+    void AddPcr(uint64_t pcr, uint64_t position);
+    static int64_t Interpolate(const Entry& previous, const Entry& next, uint64_t position);
+
+    static const int TS_PACKET_SIZE = 188;
+    static const uint8_t TS_SYNC_BYTE = 0x47;
+    static const int PCR_CLOCK = 90000;
+    static const uint64_t PCR_MASK = 0x1FFFFFFFFULL;
+    // a larger jump in the PCR is treated as a discontinuity which does not move the media time
+    static const int64_t MAX_PCR_DELTA = 10LL * PCR_CLOCK;
+    static const int64_t INDEX_INTERVAL = PCR_CLOCK;
+
+    enum class VideoCodec
+    {
+      UNKNOWN = 0,
+      MPEG2,
+      H264,
+      HEVC
+    };
+
+    // parser state, only used by the writing thread
+    uint8_t m_packet[TS_PACKET_SIZE];
+    size_t m_packetSize = 0;
+    uint64_t m_position = 0;
+    int m_pcrPid = -1;
+    int m_pmtPid = -1;
+    int m_videoPid = -1;
+    VideoCodec m_videoCodec = VideoCodec::UNKNOWN;
+    uint64_t m_lastPcr = 0;
+    int64_t m_time = -1;
+
+    /*!< @brief media time in 90kHz ticks since the first PCR at each sampled position */
+    std::deque<Entry> m_entries;
+    Entry m_latest = {0, 0};
+    std::deque<uint64_t> m_accessPoints;
+    std::mutex m_mutex;
+  };
+} // namespace enigma2
@@ -0,0 +1,148 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#include "TimeshiftMemoryBuffer.h"
+
+#include "utilities/Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+
+using namespace enigma2;
+using namespace enigma2::utilities;
+
+TimeshiftMemoryBuffer::TimeshiftMemoryBuffer(IStreamReader* streamReader, std::shared_ptr<InstanceSettings>& settings) : m_streamReader(streamReader)
+{
+  unsigned int readTimeout = settings->GetReadTimeoutSecs();
+  m_readTimeout = (readTimeout) ? readTimeout : DEFAULT_READ_TIMEOUT;
+
+  m_bufferSize = settings->GetTimeshiftMemoryBufferBytes();
+  m_buffer.reset(new (std::nothrow) uint8_t[m_bufferSize]);
+  if (!m_buffer)
+    Logger::Log(LEVEL_ERROR, "%s Timeshift: Unable to allocate memory buffer of %lld bytes", __func__, static_cast<long long>(m_bufferSize));
+}
+
+TimeshiftMemoryBuffer::~TimeshiftMemoryBuffer()
+{
+  m_running = false;
+  if (m_inputThread.joinable())
+    m_inputThread.join();
+
+  Logger::Log(LEVEL_DEBUG, "%s Timeshift: Stopped", __func__);
+}
+
+bool TimeshiftMemoryBuffer::Start()
+{
+  if (m_streamReader == nullptr || !m_buffer)
+    return false;
+  if (m_running)
+    return true;
+
+  Logger::Log(LEVEL_INFO, "%s Timeshift: Started - memory buffer of %lld MiB", __func__, static_cast<long long>(m_bufferSize / (1024 * 1024)));
+  m_start = std::time(nullptr);
+  m_running = true;
+  m_inputThread = std::thread([&] { DoRead(); });
+
+  return true;
+}
+
+void TimeshiftMemoryBuffer::DoRead()
+{
+  Logger::Log(LEVEL_DEBUG, "%s Timeshift: Thread started", __func__);
+
+  m_streamReader->Start();
+  while (m_running)
+  {
+    uint64_t writePos = m_writePos.load(std::memory_order_relaxed);
+    uint64_t bufferOffset = writePos % m_bufferSize;
+    size_t size = std::min<uint64_t>(BUFFER_SIZE, m_bufferSize - bufferOffset);
+
+    // claim the region before overwriting it so a reader still copying the oldest data can tell it has changed
+    m_writeReservePos.store(writePos + size);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    ssize_t read = m_streamReader->ReadData(m_buffer.get() + bufferOffset, size);
+    if (read <= 0)
+      continue;
+
+    m_index.AddData(m_buffer.get() + bufferOffset, read);
+    m_writePos.store(writePos + read, std::memory_order_release);
+
+    AddWriteTime(writePos + read);
+  }
+
+  Logger::Log(LEVEL_DEBUG, "%s Timeshift: Thread stopped", __func__);
+}
+
+uint64_t TimeshiftMemoryBuffer::GetReadableStartPosition()
+{
+  uint64_t writeReservePos = m_writeReservePos.load();
+
+  return writeReservePos > m_bufferSize ? writeReservePos - m_bufferSize : 0;
+}
+
+void TimeshiftMemoryBuffer::CopyFromBuffer(uint64_t position, uint8_t* buffer, size_t size) const
+{
+  uint64_t bufferOffset = position % m_bufferSize;
+  size_t firstSize = std::min<uint64_t>(size, m_bufferSize - bufferOffset);
+
+  std::memcpy(buffer, m_buffer.get() + bufferOffset, firstSize);
+  if (firstSize < size)
+    std::memcpy(buffer + firstSize, m_buffer.get(), size - firstSize);
+}
+
+ssize_t TimeshiftMemoryBuffer::ReadData(unsigned char* buffer, unsigned int size)
+{
+  /* never ask for more than the ring can hold */
+  size = std::min<uint64_t>(size, m_bufferSize / 2);
+
+  /* make sure we never read above the current write position */
+  uint64_t requiredLength = m_readPos + size;
+  auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(m_readTimeout);
+  while (m_writePos.load(std::memory_order_acquire) < requiredLength)
+  {
+    if (!m_running || std::chrono::steady_clock::now() >= timeout)
+    {
+      Logger::Log(LEVEL_DEBUG, "%s Timeshift: Read timed out; waited %d", __func__, m_readTimeout);
+      return -1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(READ_WAITTIME));
+  }
+
+  uint64_t writePos = m_writePos.load(std::memory_order_acquire);
+  while (true)
+  {
+    /* the oldest data may have been overwritten while we were paused */
+    uint64_t readPos = m_readPos;
+    uint64_t readableStartPos = GetReadableStartPosition();
+    if (readPos < readableStartPos)
+    {
+      Logger::Log(LEVEL_DEBUG, "%s Timeshift: Read position %lld was overwritten, skipping to %lld", __func__,
+                  static_cast<long long>(readPos), static_cast<long long>(readableStartPos));
+      readPos = readableStartPos;
+    }
+
+    size_t readSize = std::min<uint64_t>(size, writePos - readPos);
+    CopyFromBuffer(readPos, buffer, readSize);
+
+    /* only keep the copy if the writer did not start overwriting it in the meantime */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (readPos >= GetReadableStartPosition())
+    {
+      m_readPos = readPos + readSize;
+      return readSize;
+    }
+  }
+}
+
+bool TimeshiftMemoryBuffer::HasTimeshiftCapacity()
+{
+  // the oldest data is always overwritten so the buffer never runs out of space
+  return true;
+}
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#pragma once
+
+#include "InstanceSettings.h"
+#include "TimeshiftBufferBase.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace enigma2
+{
+  /**
+   * A timeshift buffer which keeps the most recent part of the stream in memory only.
+   *
+   * The data is held in a ring which is filled by a single input thread and read by a
+   * single consumer without any locking. The ring keeps history, so instead of the
+   * writer waiting for the reader the oldest data is overwritten and a reader that
+   * falls behind the readable window is moved forward to its start.
+   */
+  class ATTR_DLL_LOCAL TimeshiftMemoryBuffer : public TimeshiftBufferBase
+  {
+  public:
+    TimeshiftMemoryBuffer(IStreamReader* strReader, std::shared_ptr<enigma2::InstanceSettings>& settings);
+    ~TimeshiftMemoryBuffer();
+
+    bool Start() override;
+    ssize_t ReadData(unsigned char* buffer, unsigned int size) override;
+    bool HasTimeshiftCapacity() override;
+
+  protected:
+    uint64_t GetReadableStartPosition() override;
+
+  private:
+    void DoRead();
+    void CopyFromBuffer(uint64_t position, uint8_t* buffer, size_t size) const;
+
+    static const int BUFFER_SIZE = 32 * 1024;
+    static const int DEFAULT_READ_TIMEOUT = 10;
+    static const int READ_WAITTIME = 10;
+
+    IStreamReader* m_streamReader;
+    int m_readTimeout;
+
+    std::unique_ptr<uint8_t[]> m_buffer;
+    uint64_t m_bufferSize = 0;
+
+    /*!< @brief position up to which the writer may currently be overwriting data */
+    std::atomic<uint64_t> m_writeReservePos = {0};
+
+    std::atomic<bool> m_running = {false};
+    std::thread m_inputThread;
+  };
+} // namespace enigma2
@@ -0,0 +1,170 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#include "TimeshiftSegmentStorage.h"
+
+#include "utilities/Logger.h"
+
+#include <algorithm>
+
+#include <kodi/tools/StringUtils.h>
+
+using namespace enigma2;
+using namespace enigma2::utilities;
+using namespace kodi::tools;
+
+TimeshiftSegmentStorage::TimeshiftSegmentStorage(const std::string& bufferPath, uint64_t byteLimit, bool wrapAround)
+  : m_bufferPath(bufferPath), m_byteLimit(byteLimit), m_wrapAround(wrapAround && byteLimit > 0)
+{
+  // Keep several segments within the limit so removing the oldest never empties the seekable window
+  m_segmentSize = SEGMENT_SIZE;
+  if (m_wrapAround)
+    m_segmentSize = std::max<uint64_t>(std::min<uint64_t>(m_byteLimit / MIN_SEGMENT_COUNT, SEGMENT_SIZE), MIN_SEGMENT_SIZE);
+
+  OpenNextSegment();
+}
+
+TimeshiftSegmentStorage::~TimeshiftSegmentStorage()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_segmentWriteHandle.IsOpen())
+    m_segmentWriteHandle.Close();
+  if (m_segmentReadHandle.IsOpen())
+    m_segmentReadHandle.Close();
+
+  for (const auto& segment : m_segments)
+  {
+    if (!kodi::vfs::DeleteFile(GetSegmentFile(segment.m_number)))
+      Logger::Log(LEVEL_ERROR, "%s Unable to delete file when timeshift buffer is deleted: %s", __func__, GetSegmentFile(segment.m_number).c_str());
+  }
+}
+
+bool TimeshiftSegmentStorage::IsOpen()
+{
+  return m_segmentWriteHandle.IsOpen();
+}
+
+ssize_t TimeshiftSegmentStorage::Write(const uint8_t* buffer, size_t size)
+{
+  // Only this thread adds or removes segments so the last one can be used without locking
+  if (m_segments.empty() || m_segments.back().m_size >= m_segmentSize)
+  {
+    if (!OpenNextSegment())
+      return -1;
+  }
+
+  Segment& segment = m_segments.back();
+  size = std::min<uint64_t>(size, m_segmentSize - segment.m_size);
+
+  ssize_t write = m_segmentWriteHandle.Write(buffer, size);
+  if (write > 0)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    segment.m_size += write;
+  }
+
+  return write;
+}
+
+ssize_t TimeshiftSegmentStorage::Read(uint64_t position, uint8_t* buffer, size_t size)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto segmentIt = std::upper_bound(m_segments.begin(), m_segments.end(), position,
+                                    [](uint64_t position, const Segment& segment) { return position < segment.m_startPosition; });
+
+  if (segmentIt == m_segments.begin())
+    return -1;
+
+  const Segment& segment = *(--segmentIt);
+  uint64_t segmentOffset = position - segment.m_startPosition;
+
+  if (segmentOffset >= segment.m_size)
+    return 0;
+
+  if (m_readSegmentNumber != segment.m_number)
+  {
+    if (m_segmentReadHandle.IsOpen())
+      m_segmentReadHandle.Close();
+
+    m_readSegmentNumber = -1;
+    if (!m_segmentReadHandle.OpenFile(GetSegmentFile(segment.m_number), ADDON_READ_NO_CACHE))
+    {
+      Logger::Log(LEVEL_ERROR, "%s Unable to open timeshift segment file for reading: %s", __func__, GetSegmentFile(segment.m_number).c_str());
+      return -1;
+    }
+    m_readSegmentNumber = segment.m_number;
+  }
+
+  if (m_segmentReadHandle.GetPosition() != static_cast<int64_t>(segmentOffset))
+    m_segmentReadHandle.Seek(segmentOffset, SEEK_SET);
+
+  return m_segmentReadHandle.Read(buffer, std::min<uint64_t>(size, segment.m_size - segmentOffset));
+}
+
+uint64_t TimeshiftSegmentStorage::GetReadableStartPosition()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_segments.empty() ? 0 : m_segments.front().m_startPosition;
+}
+
+bool TimeshiftSegmentStorage::OpenNextSegment()
+{
+  if (m_segmentWriteHandle.IsOpen())
+    m_segmentWriteHandle.Close();
+
+  Segment segment;
+  segment.m_number = m_nextSegmentNumber++;
+  segment.m_startPosition = m_segments.empty() ? 0 : m_segments.back().m_startPosition + m_segments.back().m_size;
+  segment.m_size = 0;
+
+  if (!m_segmentWriteHandle.OpenFileForWrite(GetSegmentFile(segment.m_number), true))
+  {
+    Logger::Log(LEVEL_ERROR, "%s Unable to open timeshift segment file for writing: %s", __func__, GetSegmentFile(segment.m_number).c_str());
+    return false;
+  }
+
+  Logger::Log(LEVEL_DEBUG, "%s Timeshift: Opened segment %d at position %lld", __func__, segment.m_number, static_cast<long long>(segment.m_startPosition));
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_segments.emplace_back(segment);
+
+  if (m_wrapAround)
+    RemoveOldSegments();
+
+  return true;
+}
+
+void TimeshiftSegmentStorage::RemoveOldSegments()
+{
+  // Make sure the new segment can be filled without going over the byte limit
+  while (m_segments.size() > 1 &&
+         m_segments.back().m_startPosition - m_segments.front().m_startPosition + m_segmentSize > m_byteLimit)
+  {
+    const Segment& oldestSegment = m_segments.front();
+
+    if (m_readSegmentNumber == oldestSegment.m_number)
+    {
+      m_segmentReadHandle.Close();
+      m_readSegmentNumber = -1;
+    }
+
+    if (!kodi::vfs::DeleteFile(GetSegmentFile(oldestSegment.m_number)))
+      Logger::Log(LEVEL_ERROR, "%s Unable to delete timeshift segment file: %s", __func__, GetSegmentFile(oldestSegment.m_number).c_str());
+
+    Logger::Log(LEVEL_DEBUG, "%s Timeshift: Removed segment %d", __func__, oldestSegment.m_number);
+
+    m_segments.pop_front();
+  }
+}
+
+std::string TimeshiftSegmentStorage::GetSegmentFile(int segmentNumber) const
+{
+  return StringUtils::Format("%s/tsbuffer-%06d.ts", m_bufferPath.c_str(), segmentNumber);
+}
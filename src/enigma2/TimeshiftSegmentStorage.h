@@ -0,0 +1,64 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#pragma once
+
+#include "ITimeshiftStorage.h"
+
+#include <deque>
+#include <mutex>
+#include <string>
+
+#include <kodi/Filesystem.h>
+
+namespace enigma2
+{
+  /**
+   * Stores the timeshift buffer as a sequence of fixed size segment files. When
+   * wrapping around the oldest segments are deleted once the byte limit is reached.
+   */
+  class ATTR_DLL_LOCAL TimeshiftSegmentStorage : public ITimeshiftStorage
+  {
+  public:
+    TimeshiftSegmentStorage(const std::string& bufferPath, uint64_t byteLimit, bool wrapAround);
+    ~TimeshiftSegmentStorage();
+
+    bool IsOpen() override;
+    ssize_t Write(const uint8_t* buffer, size_t size) override;
+    ssize_t Read(uint64_t position, uint8_t* buffer, size_t size) override;
+    uint64_t GetReadableStartPosition() override;
+
+  private:
+    struct Segment
+    {
+      int m_number;
+      uint64_t m_startPosition;
+      uint64_t m_size;
+    };
+
+    bool OpenNextSegment();
+    void RemoveOldSegments();
+    std::string GetSegmentFile(int segmentNumber) const;
+
+    static const int SEGMENT_SIZE = 64 * 1024 * 1024;
+    static const int MIN_SEGMENT_SIZE = 1024 * 1024;
+    static const int MIN_SEGMENT_COUNT = 4;
+
+    std::string m_bufferPath;
+    uint64_t m_byteLimit;
+    bool m_wrapAround;
+    uint64_t m_segmentSize;
+
+    std::deque<Segment> m_segments;
+    int m_nextSegmentNumber = 0;
+    kodi::vfs::CFile m_segmentWriteHandle;
+    kodi::vfs::CFile m_segmentReadHandle;
+    int m_readSegmentNumber = -1;
+
+    std::mutex m_mutex;
+  };
+} // namespace enigma2
@@ -9,7 +9,6 @@
 
 #include "../InstanceSettings.h"
 #include "../utilities/WebUtils.h"
-#include "../utilities/XMLUtils.h"
 #include "ChannelGroup.h"
 
 #include <cinttypes>
@@ -50,16 +49,22 @@ bool Channel::operator!=(const Channel& right) const
   return !(*this == right);
 }
 
-bool Channel::UpdateFrom(TiXmlElement* channelNode)
+const XmlFieldTable& Channel::GetXmlFieldTable()
 {
-  if (!xml::GetString(channelNode, "e2servicereference", m_serviceReference))
+  static const XmlFieldTable fieldTable{"e2servicereference", "e2servicename"};
+  return fieldTable;
+}
+
+bool Channel::UpdateFrom(const XmlFields& channelFields)
+{
+  if (!channelFields.GetString("e2servicereference", m_serviceReference))
     return false;
 
   // Check whether the current element is not just a label or that it's not a hidden entry
   if (m_serviceReference.compare(0, 5, "1:64:") == 0 || m_serviceReference.compare(0, 6, "1:320:") == 0)
     return false;
 
-  if (!xml::GetString(channelNode, "e2servicename", m_channelName))
+  if (!channelFields.GetString("e2servicename", m_channelName))
     return false;
 
   m_fuzzyChannelName = m_channelName;
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include "../utilities/XmlFields.h"
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -14,7 +16,6 @@
 
 #include <kodi/addon-instance/pvr/Channels.h>
 #include <kodi/addon-instance/pvr/Providers.h>
-#include <tinyxml.h>
 
 namespace enigma2
 {
@@ -27,8 +28,8 @@ namespace enigma2
     class ATTR_DLL_LOCAL Channel
     {
     public:
-      const std::string SERVICE_REF_GENERIC_PREFIX = "1:0:1:";
-      const std::string SERVICE_REF_GENERIC_POSTFIX = ":0:0:0";
+      static inline const std::string SERVICE_REF_GENERIC_PREFIX = "1:0:1:";
+      static inline const std::string SERVICE_REF_GENERIC_POSTFIX = ":0:0:0";
       // There are at least two different service types for radio, see EN300468 Table 87
       const std::array<std::string, 3> RADIO_SERVICE_TYPES = {"2", "A", "a"};
 
@@ -93,7 +94,9 @@ namespace enigma2
 
       bool IsIptvStream() const { return m_isIptvStream; }
 
-      bool UpdateFrom(TiXmlElement* channelNode);
+      bool UpdateFrom(const enigma2::utilities::XmlFields& channelFields);
+
+      static const enigma2::utilities::XmlFieldTable& GetXmlFieldTable();
       void UpdateTo(kodi::addon::PVRChannel& left) const;
 
       void AddChannelGroup(std::shared_ptr<enigma2::data::ChannelGroup>& channelGroup);
@@ -105,10 +108,10 @@ namespace enigma2
 
       static std::string NormaliseServiceReference(const std::string& serviceReference, bool useStandardServiceReference);
       static std::string CreateStandardServiceReference(const std::string& serviceReference);
+      static std::string CreateCommonServiceReference(const std::string& serviceReference);
+      static std::string CreateGenericServiceReference(const std::string& commonServiceReference);
 
     private:
-      static std::string CreateCommonServiceReference(const std::string& serviceReference);
-      std::string CreateGenericServiceReference(const std::string& commonServiceReference);
       std::string CreateIconPath(const std::string& commonServiceReference);
       std::string ExtractIptvStreamURL();
       bool HasRadioServiceType();
@@ -7,7 +7,7 @@
 
 #include "EpgEntry.h"
 #include "Channel.h"
-#include "../utilities/XMLUtils.h"
+#include "../utilities/XmlFields.h"
 
 #include <cinttypes>
 
@@ -54,34 +54,6 @@ void EpgEntry::UpdateTo(kodi::addon::PVREPGTag& left) const
   left.SetFlags(flags);
 }
 
-bool EpgEntry::UpdateFrom(TiXmlElement* eventNode, std::map<std::string, std::shared_ptr<Channel>>& channelsMap)
-{
-  if (!xml::GetString(eventNode, "e2eventservicereference", m_serviceReference))
-    return false;
-
-  // Check whether the current element is not just a label or that it's not an empty record
-  if (m_serviceReference.compare(0, 5, "1:64:") == 0)
-    return false;
-
-  m_serviceReference = Channel::NormaliseServiceReference(m_serviceReference, m_settings->UseStandardServiceReference());
-
-  std::shared_ptr<data::Channel> channel = std::make_shared<data::Channel>(m_settings);
-
-  auto channelSearch = channelsMap.find(m_serviceReference);
-  if (channelSearch != channelsMap.end())
-    channel = channelSearch->second;
-
-  if (!channel)
-  {
-    Logger::Log(LEVEL_DEBUG, "%s could not find channel so skipping entry", __func__);
-    return false;
-  }
-
-  m_channelId = channel->GetUniqueId();
-
-  return UpdateFrom(eventNode, channel, 0, 0);
-}
-
 namespace
 {
 
@@ -99,22 +71,27 @@ std::string ParseAsW3CDateString(time_t time)
 
 } // unnamed namespace
 
-bool EpgEntry::UpdateFrom(TiXmlElement* eventNode, const std::shared_ptr<Channel>& channel, time_t iStart, time_t iEnd)
+const XmlFieldTable& EpgEntry::GetXmlFieldTable()
 {
-  std::string strTmp;
+  static const XmlFieldTable fieldTable{"e2eventid", "e2eventstart", "e2eventduration", "e2eventtitle", "e2eventdescription",
+                                        "e2eventdescriptionextended", "e2eventgenre", "e2eventservicereference"};
+  return fieldTable;
+}
 
+bool EpgEntry::UpdateFrom(const XmlFields& eventFields, const std::shared_ptr<Channel>& channel, time_t iStart, time_t iEnd)
+{
   int iTmpStart;
   int iTmp;
 
   // check and set event starttime and endtimes
-  if (!xml::GetInt(eventNode, "e2eventstart", iTmpStart))
+  if (!eventFields.GetInt("e2eventstart", iTmpStart))
     return false;
 
   // Skip unneccessary events
   if (iStart > iTmpStart)
     return false;
 
-  if (!xml::GetInt(eventNode, "e2eventduration", iTmp))
+  if (!eventFields.GetInt("e2eventduration", iTmp))
     return false;
 
   if ((iEnd > 1) && (iEnd < (iTmpStart + iTmp)))
@@ -124,44 +101,33 @@ bool EpgEntry::UpdateFrom(TiXmlElement* eventNode, const std::shared_ptr<Channel
   m_endTime = iTmpStart + iTmp;
   m_startTimeW3CDateString = ParseAsW3CDateString(m_startTime);
 
-  if (!xml::GetInt(eventNode, "e2eventid", iTmp))
+  if (!eventFields.GetInt("e2eventid", iTmp))
     return false;
 
   m_epgId = iTmp;
   m_channelId = channel->GetUniqueId();
 
-  if (!xml::GetString(eventNode, "e2eventtitle", strTmp))
+  if (!eventFields.GetString("e2eventtitle", m_title))
     return false;
 
-  m_title = strTmp;
-
-  m_serviceReference = channel->GetServiceReference().c_str();
+  m_serviceReference = channel->GetServiceReference();
 
   // Check that it's not an empty record
   if (m_epgId == 0 && m_title == "None")
     return false;
 
-  if (xml::GetString(eventNode, "e2eventdescriptionextended", strTmp))
-    m_plot = strTmp;
-
-  if (xml::GetString(eventNode, "e2eventdescription", strTmp))
-    m_plotOutline = strTmp;
+  eventFields.GetString("e2eventdescriptionextended", m_plot);
+  eventFields.GetString("e2eventdescription", m_plotOutline);
 
   ProcessPrependMode(PrependOutline::IN_EPG);
 
-  if (xml::GetString(eventNode, "e2eventgenre", strTmp))
+  if (eventFields.GetString("e2eventgenre", m_genreDescription))
   {
-    m_genreDescription = strTmp;
-
-    TiXmlElement* genreNode = eventNode->FirstChildElement("e2eventgenre");
-    if (genreNode)
+    int genreId = 0;
+    if (eventFields.GetIntAttribute("e2eventgenre", "id", genreId))
     {
-      int genreId = 0;
-      if (genreNode->QueryIntAttribute("id", &genreId) == TIXML_SUCCESS)
-      {
-        m_genreType = genreId & 0xF0;
-        m_genreSubType = genreId & 0x0F;
-      }
+      m_genreType = genreId & 0xF0;
+      m_genreSubType = genreId & 0x0F;
     }
   }
 
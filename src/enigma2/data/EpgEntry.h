@@ -9,12 +9,11 @@
 
 #include "BaseEntry.h"
 #include "Channel.h"
+#include "../utilities/XmlFields.h"
 
-#include <map>
 #include <string>
 
 #include <kodi/addon-instance/pvr/EPG.h>
-#include <tinyxml.h>
 
 namespace enigma2
 {
@@ -47,8 +46,9 @@ namespace enigma2
       void SetStartTimeW3CDate(const std::string& value) { m_startTimeW3CDateString = value; }
 
       void UpdateTo(kodi::addon::PVREPGTag& left) const;
-      bool UpdateFrom(TiXmlElement* eventNode, std::map<std::string, std::shared_ptr<Channel>>& m_channelsMap);
-      bool UpdateFrom(TiXmlElement* eventNode, const std::shared_ptr<Channel>& channel, time_t iStart, time_t iEnd);
+      bool UpdateFrom(const enigma2::utilities::XmlFields& eventFields, const std::shared_ptr<Channel>& channel, time_t iStart, time_t iEnd);
+
+      static const enigma2::utilities::XmlFieldTable& GetXmlFieldTable();
 
     protected:
       unsigned int m_epgId;
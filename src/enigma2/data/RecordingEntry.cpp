@@ -8,7 +8,6 @@
 #include "RecordingEntry.h"
 
 #include "../utilities/WebUtils.h"
-#include "../utilities/XMLUtils.h"
 
 #include <cinttypes>
 #include <cstdlib>
@@ -69,7 +68,14 @@ time_t ExtractE2TimeFromFilename(const std::string& filename)
 
 } // unnamed namespace
 
-bool RecordingEntry::UpdateFrom(TiXmlElement* recordingNode, const std::string& directory, bool deleted, Channels& channels)
+const XmlFieldTable& RecordingEntry::GetXmlFieldTable()
+{
+  static const XmlFieldTable fieldTable{"e2servicereference", "e2title", "e2description", "e2descriptionextended", "e2servicename",
+                                        "e2time", "e2length", "e2filename", "e2filesize", "e2tags"};
+  return fieldTable;
+}
+
+bool RecordingEntry::UpdateFrom(const XmlFields& recordingFields, const std::string& directory, bool deleted, Channels& channels)
 {
   std::string strTmp;
   int iTmp;
@@ -78,36 +84,28 @@ bool RecordingEntry::UpdateFrom(TiXmlElement* recordingNode, const std::string&
   m_location = directory;
   m_deleted = deleted;
 
-  if (xml::GetString(recordingNode, "e2servicereference", strTmp))
-    m_recordingId = strTmp;
+  recordingFields.GetString("e2servicereference", m_recordingId);
 
   // Need to skip any trash folders for recursive list when not deleted items
   if (!m_deleted && m_recordingId.find(directory + TRASH_FOLDER) != std::string::npos)
     return false;
 
-  if (xml::GetString(recordingNode, "e2title", strTmp))
-    m_title = strTmp;
-
-  if (xml::GetString(recordingNode, "e2description", strTmp))
-    m_plotOutline = strTmp;
-
-  if (xml::GetString(recordingNode, "e2descriptionextended", strTmp))
-    m_plot = strTmp;
-
-  if (xml::GetString(recordingNode, "e2servicename", strTmp))
-    m_channelName = strTmp;
+  recordingFields.GetString("e2title", m_title);
+  recordingFields.GetString("e2description", m_plotOutline);
+  recordingFields.GetString("e2descriptionextended", m_plot);
+  recordingFields.GetString("e2servicename", m_channelName);
 
-  if (xml::GetInt(recordingNode, "e2time", iTmp))
+  if (recordingFields.GetInt("e2time", iTmp))
   {
     m_startTime = iTmp;
 
-    if (m_startTime < 0 && xml::GetString(recordingNode, "e2filename", strTmp))
+    if (m_startTime < 0 && recordingFields.GetString("e2filename", strTmp))
       m_startTime = ExtractE2TimeFromFilename(strTmp);
 
     m_startTimeW3CDateString = ParseAsW3CDateString(m_startTime);
   }
 
-  if (xml::GetString(recordingNode, "e2length", strTmp))
+  if (recordingFields.GetString("e2length", strTmp))
   {
     iTmp = TimeStringToSeconds(strTmp.c_str());
     m_duration = iTmp;
@@ -115,7 +113,7 @@ bool RecordingEntry::UpdateFrom(TiXmlElement* recordingNode, const std::string&
   else
     m_duration = 0;
 
-  if (xml::GetString(recordingNode, "e2filename", strTmp))
+  if (recordingFields.GetString("e2filename", strTmp))
   {
     const std::string& filename = strTmp;
     size_t found = filename.find_last_of('/');
@@ -132,14 +130,12 @@ bool RecordingEntry::UpdateFrom(TiXmlElement* recordingNode, const std::string&
   }
 
   double filesizeInBytes;
-  if (xml::GetDouble(recordingNode, "e2filesize", filesizeInBytes))
+  if (recordingFields.GetDouble("e2filesize", filesizeInBytes))
     m_sizeInBytes = static_cast<int64_t>(filesizeInBytes);
 
   ProcessPrependMode(PrependOutline::IN_RECORDINGS);
 
-  m_tags.clear();
-  if (xml::GetString(recordingNode, "e2tags", strTmp))
-    m_tags = strTmp;
+  recordingFields.GetString("e2tags", m_tags);
 
   if (ContainsTag(TAG_FOR_GENRE_ID))
   {
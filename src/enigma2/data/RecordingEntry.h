@@ -8,6 +8,7 @@
 #pragma once
 
 #include "../Channels.h"
+#include "../utilities/XmlFields.h"
 #include "BaseEntry.h"
 #include "Channel.h"
 #include "Tags.h"
@@ -15,7 +16,6 @@
 #include <string>
 
 #include <kodi/addon-instance/pvr/Recordings.h>
-#include <tinyxml.h>
 
 namespace enigma2
 {
@@ -95,7 +95,9 @@ namespace enigma2
       int64_t GetSizeInBytes() const { return m_sizeInBytes; }
       void SetSizeInBytes(int64_t value) { m_sizeInBytes = value; }
 
-      bool UpdateFrom(TiXmlElement* recordingNode, const std::string& directory, bool deleted, enigma2::Channels& channels);
+      bool UpdateFrom(const enigma2::utilities::XmlFields& recordingFields, const std::string& directory, bool deleted, enigma2::Channels& channels);
+
+      static const enigma2::utilities::XmlFieldTable& GetXmlFieldTable();
       void UpdateTo(kodi::addon::PVRRecording& left, Channels& channels, bool isInVirtualRecordingFolder);
 
     private:
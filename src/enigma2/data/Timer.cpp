@@ -7,8 +7,6 @@
 
 #include "Timer.h"
 
-#include "../utilities/XMLUtils.h"
-
 #include <cinttypes>
 #include <regex>
 
@@ -162,7 +160,14 @@ bool Timer::IsChildOfParent(const Timer& parent) const
   return isChild;
 }
 
-bool Timer::UpdateFrom(TiXmlElement* timerNode, Channels& channels)
+const XmlFieldTable& Timer::GetXmlFieldTable()
+{
+  static const XmlFieldTable fieldTable{"e2name", "e2state", "e2disabled", "e2servicereference", "e2timebegin", "e2timeend",
+                                        "e2descriptionextended", "e2description", "e2repeated", "e2eit", "e2cancled", "e2tags"};
+  return fieldTable;
+}
+
+bool Timer::UpdateFrom(const XmlFields& timerFields, Channels& channels)
 {
   std::string strTmp;
 
@@ -170,18 +175,18 @@ bool Timer::UpdateFrom(TiXmlElement* timerNode, Channels& channels)
   bool bTmp;
   int iDisabled;
 
-  if (xml::GetString(timerNode, "e2name", strTmp))
+  if (timerFields.GetString("e2name", strTmp))
     Logger::Log(LEVEL_DEBUG, "%s Processing timer '%s'", __func__, strTmp.c_str());
 
-  if (!xml::GetInt(timerNode, "e2state", iTmp))
+  if (!timerFields.GetInt("e2state", iTmp))
     return false;
 
-  if (!xml::GetInt(timerNode, "e2disabled", iDisabled))
+  if (!timerFields.GetInt("e2disabled", iDisabled))
     return false;
 
   m_title = strTmp;
 
-  if (xml::GetString(timerNode, "e2servicereference", strTmp))
+  if (timerFields.GetString("e2servicereference", strTmp))
   {
     m_serviceReference = strTmp;
     m_channelId = channels.GetChannelUniqueId(Channel::NormaliseServiceReference(strTmp.c_str(), m_settings->UseStandardServiceReference()));
@@ -198,21 +203,18 @@ bool Timer::UpdateFrom(TiXmlElement* timerNode, Channels& channels)
   }
 
 
-  if (!xml::GetInt(timerNode, "e2timebegin", iTmp))
+  if (!timerFields.GetInt("e2timebegin", iTmp))
     return false;
 
   m_startTime = iTmp;
 
-  if (!xml::GetInt(timerNode, "e2timeend", iTmp))
+  if (!timerFields.GetInt("e2timeend", iTmp))
     return false;
 
   m_endTime = iTmp;
 
-  if (xml::GetString(timerNode, "e2descriptionextended", strTmp))
-    m_plot = strTmp;
-
-  if (xml::GetString(timerNode, "e2description", strTmp))
-    m_plotOutline = strTmp;
+  timerFields.GetString("e2descriptionextended", m_plot);
+  timerFields.GetString("e2description", m_plotOutline);
 
   if (m_plot == "N/A")
     m_plot.clear();
@@ -230,19 +232,19 @@ bool Timer::UpdateFrom(TiXmlElement* timerNode, Channels& channels)
     m_plotOutline.clear();
   }
 
-  if (xml::GetInt(timerNode, "e2repeated", iTmp))
+  if (timerFields.GetInt("e2repeated", iTmp))
     m_weekdays = iTmp;
   else
     m_weekdays = 0;
 
-  if (xml::GetInt(timerNode, "e2eit", iTmp))
+  if (timerFields.GetInt("e2eit", iTmp))
     m_epgId = iTmp;
   else
     m_epgId = 0;
 
   m_state = PVR_TIMER_STATE_NEW;
 
-  if (!xml::GetInt(timerNode, "e2state", iTmp))
+  if (!timerFields.GetInt("e2state", iTmp))
     return false;
 
   Logger::Log(LEVEL_DEBUG, "%s e2state is: %d ", __func__, iTmp);
@@ -265,7 +267,7 @@ bool Timer::UpdateFrom(TiXmlElement* timerNode, Channels& channels)
     Logger::Log(LEVEL_DEBUG, "%s Timer state is: COMPLETED", __func__);
   }
 
-  if (xml::GetBoolean(timerNode, "e2cancled", bTmp))
+  if (timerFields.GetBoolean("e2cancled", bTmp))
   {
     if (bTmp)
     {
@@ -292,9 +294,7 @@ bool Timer::UpdateFrom(TiXmlElement* timerNode, Channels& channels)
     Logger::Log(LEVEL_DEBUG, "%s Overriding Timer as channel not found, state is: ERROR", __func__);
   }
 
-  m_tags.clear();
-  if (xml::GetString(timerNode, "e2tags", strTmp))
-    m_tags = strTmp;
+  timerFields.GetString("e2tags", m_tags);
 
   if (ContainsTag(TAG_FOR_MANUAL_TIMER))
   {
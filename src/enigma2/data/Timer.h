@@ -9,6 +9,7 @@
 
 #include "../Channels.h"
 #include "../utilities/UpdateState.h"
+#include "../utilities/XmlFields.h"
 #include "BaseEntry.h"
 #include "Tags.h"
 
@@ -17,7 +18,6 @@
 #include <type_traits>
 
 #include <kodi/addon-instance/pvr/Timers.h>
-#include <tinyxml.h>
 
 namespace enigma2
 {
@@ -88,7 +88,9 @@ namespace enigma2
       bool operator==(const Timer& right) const;
       void UpdateFrom(const Timer& right);
       void UpdateTo(kodi::addon::PVRTimer& right) const;
-      bool UpdateFrom(TiXmlElement* timerNode, Channels& channels);
+      bool UpdateFrom(const enigma2::utilities::XmlFields& timerFields, Channels& channels);
+
+      static const enigma2::utilities::XmlFieldTable& GetXmlFieldTable();
 
     protected:
       Type m_type = Type::MANUAL_ONCE;
@@ -146,7 +146,7 @@ bool GenreIdMapper::LoadIdToIdGenreFile(const std::string& xmlFile, std::map<int
 
       map.insert({sourceId, targetId});
 
-      Logger::Log(LEVEL_TRACE, "%s Read ID Mapping for: %s, sourceId=%#02X, targetId=%#02X", __func__, mapperName.c_str(), sourceId, targetId);
+      VUPLUS_LOG(LEVEL_TRACE, "%s Read ID Mapping for: %s, sourceId=%#02X, targetId=%#02X", __func__, mapperName.c_str(), sourceId, targetId);
     }
   }
 
@@ -198,7 +198,7 @@ bool GenreRytecTextMapper::LoadTextToIdGenreFile(const std::string& xmlFile, std
 
       map.insert({textMapping, targetId});
 
-      Logger::Log(LEVEL_TRACE, "%s Read Text Mapping for: %s, text=%s, targetId=%#02X", __func__, mapperName.c_str(), textMapping.c_str(), targetId);
+      VUPLUS_LOG(LEVEL_TRACE, "%s Read Text Mapping for: %s, text=%s, targetId=%#02X", __func__, mapperName.c_str(), textMapping.c_str(), targetId);
     }
   }
 
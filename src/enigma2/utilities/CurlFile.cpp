@@ -9,9 +9,13 @@
 
 #include "../InstanceSettings.h"
 #include "Logger.h"
+#include "RequestScheduler.h"
 #include "WebUtils.h"
 
+#include <algorithm>
 #include <cstdarg>
+#include <cstdlib>
+#include <vector>
 
 #include <kodi/Filesystem.h>
 
@@ -19,19 +23,68 @@ using namespace enigma2::utilities;
 
 bool CurlFile::Get(const std::string& strURL, std::string& strResult)
 {
+  RequestScheduler::Ticket ticket;
+
+  kodi::vfs::CFile fileHandle;
+  if (!fileHandle.OpenFile(strURL))
+    return false;
+
+  return ReadAll(fileHandle, strResult);
+}
+
+bool CurlFile::Get(const std::string& strURL, const CurlDataHandler& dataHandler)
+{
+  RequestScheduler::Ticket ticket;
+
   kodi::vfs::CFile fileHandle;
-  if (fileHandle.OpenFile(strURL))
+  if (!fileHandle.OpenFile(strURL, ADDON_READ_NO_CACHE))
+    return false;
+
+  std::vector<char> buffer(READ_BLOCK_SIZE);
+  ssize_t bytesRead;
+  while ((bytesRead = fileHandle.Read(buffer.data(), buffer.size())) > 0)
   {
-    std::string buffer;
-    while (fileHandle.ReadLine(buffer))
-      strResult.append(buffer);
+    if (!dataHandler(buffer.data(), bytesRead))
+      break;
+  }
+
+  return bytesRead >= 0;
+}
+
+bool CurlFile::GetIfModified(const std::string& strURL, std::string& eTag, std::string& lastModified, std::string& strResult, bool& notModified)
+{
+  notModified = false;
+
+  RequestScheduler::Ticket ticket;
+
+  kodi::vfs::CFile fileHandle;
+  if (!fileHandle.CURLCreate(strURL))
+    return false;
+
+  if (!eTag.empty())
+    fileHandle.CURLAddOption(ADDON_CURL_OPTION_HEADER, "If-None-Match", eTag);
+  if (!lastModified.empty())
+    fileHandle.CURLAddOption(ADDON_CURL_OPTION_HEADER, "If-Modified-Since", lastModified);
+
+  if (!fileHandle.CURLOpen(ADDON_READ_NO_CACHE))
+    return false;
+
+  if (GetResponseCode(fileHandle) == HTTP_NOT_MODIFIED)
+  {
+    notModified = true;
     return true;
   }
-  return false;
+
+  eTag = fileHandle.GetPropertyValue(ADDON_FILE_PROPERTY_RESPONSE_HEADER, "ETag");
+  lastModified = fileHandle.GetPropertyValue(ADDON_FILE_PROPERTY_RESPONSE_HEADER, "Last-Modified");
+
+  return ReadAll(fileHandle, strResult);
 }
 
 bool CurlFile::Post(const std::string& strURL, std::string& strResult)
 {
+  RequestScheduler::Ticket ticket;
+
   kodi::vfs::CFile fileHandle;
   if (!fileHandle.CURLCreate(strURL))
   {
@@ -47,9 +100,11 @@ bool CurlFile::Post(const std::string& strURL, std::string& strResult)
     return false;
   }
 
-  std::string buffer;
-  while (fileHandle.ReadLine(buffer))
-    strResult.append(buffer);
+  if (!ReadAll(fileHandle, strResult))
+  {
+    Logger::Log(LEVEL_ERROR, "%s Unable to read response from url: %s", __func__, WebUtils::RedactUrl(strURL).c_str());
+    return false;
+  }
 
   if (!strResult.empty())
     return true;
@@ -71,9 +126,47 @@ bool CurlFile::Check(const std::string& strURL, int connectionTimeoutSecs)
 
   if (!fileHandle.CURLOpen(ADDON_READ_NO_CACHE))
   {
-    Logger::Log(LEVEL_TRACE, "%s Unable to open url: %s", __func__, WebUtils::RedactUrl(strURL).c_str());
+    VUPLUS_LOG(LEVEL_TRACE, "%s Unable to open url: %s", __func__, WebUtils::RedactUrl(strURL).c_str());
     return false;
   }
 
   return true;
 }
+
+bool CurlFile::ReadAll(kodi::vfs::CFile& fileHandle, std::string& strResult)
+{
+  size_t size = strResult.size();
+
+  // When the length is known the whole response fits without growing the string, the
+  // extra byte means the read that hits the end of the response does not grow it either
+  const int64_t contentLength = fileHandle.GetLength();
+  if (contentLength > 0)
+    strResult.reserve(size + static_cast<size_t>(contentLength) + 1);
+
+  ssize_t bytesRead;
+  do
+  {
+    size_t blockSize = strResult.capacity() > size ? std::min<size_t>(strResult.capacity() - size, READ_BLOCK_SIZE) : READ_BLOCK_SIZE;
+    strResult.resize(size + blockSize);
+
+    bytesRead = fileHandle.Read(&strResult[size], blockSize);
+    if (bytesRead > 0)
+      size += bytesRead;
+  } while (bytesRead > 0);
+
+  strResult.resize(size);
+
+  return bytesRead == 0;
+}
+
+int CurlFile::GetResponseCode(const kodi::vfs::CFile& fileHandle)
+{
+  // e.g. "HTTP/1.1 304 Not Modified"
+  const std::string protocol = fileHandle.GetPropertyValue(ADDON_FILE_PROPERTY_RESPONSE_PROTOCOL, "");
+
+  size_t codePos = protocol.find(' ');
+  if (codePos == std::string::npos)
+    return 0;
+
+  return std::atoi(protocol.c_str() + codePos + 1);
+}
@@ -7,12 +7,20 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 
+#include <kodi/Filesystem.h>
+
 namespace enigma2
 {
   namespace utilities
   {
+    /**
+     * Short-hand for a function that receives the response body as it arrives, return false to stop reading
+     */
+    typedef std::function<bool(const char* data, size_t size)> CurlDataHandler;
+
     class CurlFile
     {
     public:
@@ -20,8 +28,27 @@ namespace enigma2
       ~CurlFile() {};
 
       bool Get(const std::string& strURL, std::string& strResult);
+      bool Get(const std::string& strURL, const CurlDataHandler& dataHandler);
+
+      /**
+       * Conditional GET using the validators of an earlier response, the validators of this response are returned in their place
+       * @return false if the request failed, notModified is set if the server answered 304 Not Modified
+       */
+      bool GetIfModified(const std::string& strURL, std::string& eTag, std::string& lastModified, std::string& strResult, bool& notModified);
       bool Post(const std::string& strURL, std::string& strResult);
       bool Check(const std::string& strURL, int connectionTimeoutSecs);
+
+    private:
+      /**
+       * Reads the rest of the response in large blocks, newlines included
+       * @return false if reading failed part way
+       */
+      static bool ReadAll(kodi::vfs::CFile& fileHandle, std::string& strResult);
+      static int GetResponseCode(const kodi::vfs::CFile& fileHandle);
+
+      static const int HTTP_NOT_MODIFIED = 304;
+
+      static const int READ_BLOCK_SIZE = 64 * 1024;
     };
   } // namespace utilities
 } // namespace enigma2
@@ -7,6 +7,7 @@
 
 #include "Logger.h"
 
+#include <chrono>
 #include <cstdarg>
 
 #include <kodi/tools/StringUtils.h>
@@ -14,12 +15,20 @@
 using namespace enigma2::utilities;
 using namespace kodi::tools;
 
-Logger::Logger()
+Logger::Logger() : m_enabledLevels(~0u)
 {
   // Use an empty implementation by default
   SetImplementation([](LogLevel level, const char* message)
   {
   });
+
+  for (size_t i = 0; i < RING_SIZE; i++)
+    m_ring[i].m_sequence.store(i, std::memory_order_relaxed);
+}
+
+Logger::~Logger()
+{
+  SetAsync(false);
 }
 
 Logger& Logger::GetInstance()
@@ -30,6 +39,9 @@ Logger& Logger::GetInstance()
 
 void Logger::Log(LogLevel level, const char* message, ...)
 {
+  if (!IsLevelEnabled(level))
+    return;
+
   auto& logger = GetInstance();
 
   std::string logMessage;
@@ -46,6 +58,20 @@ void Logger::Log(LogLevel level, const char* message, ...)
   logMessage = StringUtils::FormatV(logMessage.c_str(), arguments);
   va_end(arguments);
 
+  // Counted before checking async so switching it off can wait for this push
+  logger.m_asyncProducers.fetch_add(1);
+  if (logger.m_async.load())
+  {
+    if (logger.PushRecord(level, logMessage))
+      logger.m_drainCondition.notify_one();
+    else
+      logger.m_droppedRecords.fetch_add(1, std::memory_order_relaxed);
+
+    logger.m_asyncProducers.fetch_sub(1, std::memory_order_release);
+    return;
+  }
+  logger.m_asyncProducers.fetch_sub(1, std::memory_order_relaxed);
+
   logger.m_implementation(level, logMessage.c_str());
 }
 
@@ -54,7 +80,131 @@ void Logger::SetImplementation(LoggerImplementation implementation)
   m_implementation = implementation;
 }
 
+void Logger::SetAsync(bool async)
+{
+  std::lock_guard<std::mutex> lock(m_asyncMutex);
+
+  if (async == m_async)
+    return;
+
+  if (async)
+  {
+    m_drainRunning = true;
+    m_drainThread = std::thread([this] { Process(); });
+    m_async = true;
+    return;
+  }
+
+  m_async = false;
+
+  // A thread which still saw async on may have claimed a slot without filling it yet
+  while (m_asyncProducers.load(std::memory_order_acquire) != 0)
+    std::this_thread::yield();
+
+  m_drainRunning = false;
+  m_drainCondition.notify_one();
+
+  if (m_drainThread.joinable())
+    m_drainThread.join();
+
+  // Anything pushed just before async was switched off
+  WriteQueuedRecords();
+}
+
+void Logger::SetLevelEnabled(LogLevel level, bool enabled)
+{
+  if (enabled)
+    m_enabledLevels.fetch_or(1u << level);
+  else
+    m_enabledLevels.fetch_and(~(1u << level));
+}
+
 void Logger::SetPrefix(const std::string& prefix)
 {
   m_prefix = prefix;
 }
+
+bool Logger::PushRecord(LogLevel level, std::string& message)
+{
+  size_t position = m_pushPosition.load(std::memory_order_relaxed);
+  Record* record;
+
+  for (;;)
+  {
+    record = &m_ring[position & (RING_SIZE - 1)];
+    const size_t sequence = record->m_sequence.load(std::memory_order_acquire);
+
+    if (sequence == position)
+    {
+      // The slot is free, claim it unless another thread got there first
+      if (m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        break;
+    }
+    else if (sequence < position)
+    {
+      // The slot still holds a record from the previous lap, the ring is full
+      return false;
+    }
+    else
+    {
+      position = m_pushPosition.load(std::memory_order_relaxed);
+    }
+  }
+
+  record->m_level = level;
+  record->m_message = std::move(message);
+  record->m_sequence.store(position + 1, std::memory_order_release);
+
+  return true;
+}
+
+bool Logger::PopRecord(LogLevel& level, std::string& message)
+{
+  Record& record = m_ring[m_popPosition & (RING_SIZE - 1)];
+
+  if (record.m_sequence.load(std::memory_order_acquire) != m_popPosition + 1)
+    return false;
+
+  level = record.m_level;
+  message = std::move(record.m_message);
+  record.m_sequence.store(m_popPosition + RING_SIZE, std::memory_order_release);
+  m_popPosition++;
+
+  return true;
+}
+
+void Logger::Process()
+{
+  while (m_drainRunning)
+  {
+    WriteQueuedRecords();
+
+    // A notify that is missed while writing is picked up by the timeout
+    std::unique_lock<std::mutex> lock(m_drainMutex);
+    m_drainCondition.wait_for(lock, std::chrono::milliseconds(DRAIN_INTERVAL_MS));
+  }
+
+  WriteQueuedRecords();
+}
+
+void Logger::WriteQueuedRecords()
+{
+  LogLevel level;
+  std::string message;
+
+  while (PopRecord(level, message))
+    m_implementation(level, message.c_str());
+
+  const unsigned int droppedRecords = m_droppedRecords.load(std::memory_order_relaxed);
+  if (droppedRecords != m_reportedDroppedRecords)
+  {
+    std::string dropMessage;
+    if (!m_prefix.empty())
+      dropMessage = m_prefix + " - ";
+    dropMessage += StringUtils::Format("%s %u log messages dropped as the log queue was full, %u in total", __func__,
+                                       droppedRecords - m_reportedDroppedRecords, droppedRecords);
+
+    m_implementation(LEVEL_WARNING, dropMessage.c_str());
+    m_reportedDroppedRecords = droppedRecords;
+  }
+}
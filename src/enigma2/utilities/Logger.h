@@ -7,8 +7,14 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <functional>
+#include <mutex>
 #include <string>
+#include <thread>
 
 namespace enigma2
 {
@@ -36,10 +42,17 @@ namespace enigma2
      * The logger class. It is a singleton that by default comes with no
      * underlying implementation. It is up to the user to supply a suitable
      * implementation as a lambda using SetImplementation().
+     *
+     * In async mode the formatted messages are queued in a fixed size ring and
+     * handed to the implementation by a dedicated thread, so a slow log target
+     * never holds up the caller. When the ring is full messages are dropped and
+     * counted instead of waiting for space.
      */
     class Logger
     {
     public:
+      ~Logger();
+
       /**
        * Returns the singleton instance
        * @return
@@ -54,12 +67,48 @@ namespace enigma2
        */
       static void Log(LogLevel level, const char* message, ...);
 
+      /**
+       * Checks whether messages of the specified level are logged at all
+       * @param level the log level
+       * @return false if messages of the level are dropped
+       */
+      static bool IsLevelEnabled(LogLevel level)
+      {
+#ifdef VUPLUS_DISABLE_TRACE_LOGGING
+        if (level == LEVEL_TRACE)
+          return false;
+#endif
+        return (GetInstance().m_enabledLevels.load(std::memory_order_relaxed) & (1u << level)) != 0;
+      }
+
+      /**
+       * Enables or disables the specified log level, messages of a disabled level
+       * are dropped before they are formatted
+       * @param level the log level
+       * @param enabled
+       */
+      void SetLevelEnabled(LogLevel level, bool enabled);
+
       /**
        * Configures the logger to use the specified implementation
        * @param implementation lambda
        */
       void SetImplementation(LoggerImplementation implementation);
 
+      /**
+       * Switches async mode on or off. Switching it off writes out all queued
+       * messages before returning. The implementation must not be changed while
+       * async mode is on.
+       * @param async
+       */
+      void SetAsync(bool async);
+
+      /**
+       * Returns the number of messages dropped because the async ring was full
+       * @return
+       */
+      unsigned int GetDroppedRecordCount() const { return m_droppedRecords.load(std::memory_order_relaxed); }
+
       /**
        * Sets the prefix to use in log messages
        * @param prefix
@@ -67,8 +116,27 @@ namespace enigma2
       void SetPrefix(const std::string& prefix);
 
     private:
+      /**
+       * A formatted message in the async ring. The sequence tells whether the
+       * slot is free for the producer or filled for the drain thread.
+       */
+      struct Record
+      {
+        std::atomic<size_t> m_sequence;
+        LogLevel m_level;
+        std::string m_message;
+      };
+
       Logger();
 
+      bool PushRecord(LogLevel level, std::string& message);
+      bool PopRecord(LogLevel& level, std::string& message);
+      void Process();
+      void WriteQueuedRecords();
+
+      static constexpr size_t RING_SIZE = 1024; // must be a power of two
+      static constexpr int DRAIN_INTERVAL_MS = 100;
+
       /**
        * The logger implementation
        */
@@ -78,6 +146,42 @@ namespace enigma2
        * The log message prefix
        */
       std::string m_prefix;
+
+      /**
+       * Bit mask of the enabled log levels
+       */
+      std::atomic<unsigned int> m_enabledLevels;
+
+      /**
+       * The async ring, any thread can push while only the drain thread pops
+       */
+      std::array<Record, RING_SIZE> m_ring;
+      std::atomic<size_t> m_pushPosition{0};
+      size_t m_popPosition = 0;
+
+      std::atomic<bool> m_async{false};
+      // threads which have seen async on and may not have published their record yet
+      std::atomic<unsigned int> m_asyncProducers{0};
+      std::atomic<unsigned int> m_droppedRecords{0};
+      unsigned int m_reportedDroppedRecords = 0;
+
+      std::thread m_drainThread;
+      std::atomic<bool> m_drainRunning{false};
+      std::mutex m_drainMutex;
+      std::condition_variable m_drainCondition;
+      std::mutex m_asyncMutex;
     };
   } // namespace utilities
 } // namespace enigma2
+
+/**
+ * Logs like Logger::Log but only evaluates the arguments when the level is enabled, so
+ * e.g. strings built just for the message cost nothing while it is switched off. With
+ * VUPLUS_DISABLE_TRACE_LOGGING trace messages are removed from the build entirely.
+ */
+#define VUPLUS_LOG(level, ...) \
+  do \
+  { \
+    if (enigma2::utilities::Logger::IsLevelEnabled(level)) \
+      enigma2::utilities::Logger::Log(level, __VA_ARGS__); \
+  } while (0)
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#include "RateLimiter.h"
+
+#include "Logger.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace enigma2;
+using namespace enigma2::utilities;
+
+void RateLimiter::Acquire(int minIntervalMs)
+{
+  std::chrono::steady_clock::time_point sendTime;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsedSecs = std::chrono::duration<double>(now - m_lastRefill).count();
+    m_tokens = std::min(BURST_SIZE, m_tokens + elapsedSecs * m_rate);
+    m_lastRefill = now;
+
+    // Take the token now, if there is none the caller waits until it would have been refilled
+    m_tokens -= 1.0;
+    sendTime = now;
+    if (m_tokens < 0)
+      sendTime += std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(-m_tokens / m_rate));
+
+    if (minIntervalMs > 0)
+      sendTime = std::max(sendTime, m_lastRequest + std::chrono::milliseconds(minIntervalMs));
+
+    m_lastRequest = std::max(sendTime, m_lastRequest);
+  }
+
+  std::this_thread::sleep_until(sendTime);
+}
+
+void RateLimiter::OnResponse(int latencyMs)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_baselineLatencyMs <= 0 || latencyMs < m_baselineLatencyMs)
+    m_baselineLatencyMs = latencyMs;
+  else
+    m_baselineLatencyMs += (latencyMs - m_baselineLatencyMs) * BASELINE_DRIFT;
+
+  const double slowLatencyMs = std::max(m_baselineLatencyMs * SLOW_RESPONSE_FACTOR, m_baselineLatencyMs + SLOW_RESPONSE_MIN_EXTRA_MS);
+
+  if (latencyMs > slowLatencyMs)
+    DecreaseRate(latencyMs);
+  else
+    m_rate = std::min(MAX_RATE, m_rate + RATE_INCREASE / m_rate); // about RATE_INCREASE per second
+}
+
+void RateLimiter::OnFailure()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  DecreaseRate(static_cast<int>(m_baselineLatencyMs));
+}
+
+double RateLimiter::GetRate() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_rate;
+}
+
+void RateLimiter::DecreaseRate(int latencyMs)
+{
+  // Responses to requests sent before the last decrease still reflect the old rate so only back off once per round trip
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_lastDecrease < std::chrono::milliseconds(latencyMs + SLOW_RESPONSE_MIN_EXTRA_MS))
+    return;
+
+  m_lastDecrease = now;
+  m_rate = std::max(MIN_RATE, m_rate * RATE_DECREASE_FACTOR);
+  m_tokens = std::min(m_tokens, 0.0);
+
+  Logger::Log(LEVEL_DEBUG, "%s Set-top box is slowing down, reducing request rate to %.2f per second", __func__, m_rate);
+}
@@ -0,0 +1,69 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+
+namespace enigma2
+{
+  namespace utilities
+  {
+    /**
+     * Token bucket rate limiter whose rate adapts to how fast the set-top box
+     * answers (AIMD). The rate is increased additively while response times stay
+     * close to the fastest seen and halved as soon as they grow or a request fails.
+     */
+    class RateLimiter
+    {
+    public:
+      /**
+       * Waits until the next request may be sent
+       * @param minIntervalMs minimum time between two requests regardless of the current rate
+       */
+      void Acquire(int minIntervalMs);
+
+      /**
+       * Reports the time taken for a successful request
+       * @param latencyMs the response time in milliseconds
+       */
+      void OnResponse(int latencyMs);
+
+      /**
+       * Reports a failed request
+       */
+      void OnFailure();
+
+      double GetRate() const;
+
+    private:
+      void DecreaseRate(int latencyMs);
+
+      static constexpr double MIN_RATE = 0.2; // requests per second
+      static constexpr double MAX_RATE = 20.0;
+      static constexpr double INITIAL_RATE = 5.0;
+      static constexpr double RATE_INCREASE = 0.5;
+      static constexpr double RATE_DECREASE_FACTOR = 0.5;
+      static constexpr double BURST_SIZE = 4.0;
+      // A response counts as slow when it takes this much longer than the baseline
+      static constexpr double SLOW_RESPONSE_FACTOR = 2.0;
+      static const int SLOW_RESPONSE_MIN_EXTRA_MS = 250;
+      // The baseline slowly drifts up so a box that becomes permanently slower is not throttled forever
+      static constexpr double BASELINE_DRIFT = 0.02;
+
+      double m_rate = INITIAL_RATE;
+      double m_tokens = BURST_SIZE;
+      double m_baselineLatencyMs = 0;
+      std::chrono::steady_clock::time_point m_lastRefill = std::chrono::steady_clock::now();
+      std::chrono::steady_clock::time_point m_lastRequest;
+      std::chrono::steady_clock::time_point m_lastDecrease;
+
+      mutable std::mutex m_mutex;
+    };
+  } // namespace utilities
+} // namespace enigma2
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#include "RequestScheduler.h"
+
+#include "Logger.h"
+
+using namespace enigma2;
+using namespace enigma2::utilities;
+
+namespace
+{
+  // Kodi's own threads are acting for the user unless told otherwise
+  thread_local RequestPriority threadPriority = RequestPriority::USER_ACTION;
+
+  // A thread that is already sending a request is never held up again, e.g. when a
+  // request is made while a streamed response is still being read, as that could deadlock
+  thread_local int ticketsHeldByThread = 0;
+
+  int ToIndex(RequestPriority priority)
+  {
+    return static_cast<int>(priority);
+  }
+} // unnamed namespace
+
+const std::array<int, static_cast<int>(RequestPriority::COUNT)> RequestScheduler::CONCURRENCY_LIMITS = {
+  2, // PLAYBACK
+  4, // USER_ACTION
+  2, // BACKGROUND
+};
+
+RequestScheduler::Ticket::Ticket()
+  : m_priority(threadPriority), m_scheduled(ticketsHeldByThread == 0)
+{
+  if (m_scheduled)
+    RequestScheduler::GetInstance().Acquire(m_priority);
+
+  ticketsHeldByThread++;
+}
+
+RequestScheduler::Ticket::~Ticket()
+{
+  ticketsHeldByThread--;
+
+  if (m_scheduled)
+    RequestScheduler::GetInstance().Release(m_priority);
+}
+
+RequestScheduler& RequestScheduler::GetInstance()
+{
+  static RequestScheduler scheduler;
+  return scheduler;
+}
+
+RequestPriority RequestScheduler::GetCurrentPriority()
+{
+  return threadPriority;
+}
+
+void RequestScheduler::Acquire(RequestPriority priority)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  if (!CanRun(priority))
+  {
+    VUPLUS_LOG(LEVEL_TRACE, "%s Request of class %d waiting, %d playback, %d user action and %d background requests running", __func__,
+                ToIndex(priority), m_running[ToIndex(RequestPriority::PLAYBACK)], m_running[ToIndex(RequestPriority::USER_ACTION)],
+                m_running[ToIndex(RequestPriority::BACKGROUND)]);
+
+    m_waiting[ToIndex(priority)]++;
+    m_condition.wait(lock, [this, priority] { return CanRun(priority); });
+    m_waiting[ToIndex(priority)]--;
+  }
+
+  m_running[ToIndex(priority)]++;
+}
+
+void RequestScheduler::Release(RequestPriority priority)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_running[ToIndex(priority)]--;
+
+  m_condition.notify_all();
+}
+
+bool RequestScheduler::CanRun(RequestPriority priority) const
+{
+  if (m_running[ToIndex(priority)] >= CONCURRENCY_LIMITS[ToIndex(priority)])
+    return false;
+
+  // More important requests go first
+  for (int i = 0; i < ToIndex(priority); i++)
+  {
+    if (m_waiting[i] > 0)
+      return false;
+  }
+
+  // The box gets all its attention for playback
+  if (priority == RequestPriority::BACKGROUND && m_running[ToIndex(RequestPriority::PLAYBACK)] > 0)
+    return false;
+
+  return true;
+}
+
+RequestPriorityScope::RequestPriorityScope(RequestPriority priority)
+  : m_previousPriority(threadPriority)
+{
+  threadPriority = priority;
+}
+
+RequestPriorityScope::~RequestPriorityScope()
+{
+  threadPriority = m_previousPriority;
+}
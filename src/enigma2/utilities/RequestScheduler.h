@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <mutex>
+
+namespace enigma2
+{
+  namespace utilities
+  {
+    /**
+     * The classes of requests to the set-top box, most important first
+     */
+    enum class RequestPriority
+    {
+      PLAYBACK = 0,
+      USER_ACTION,
+      BACKGROUND,
+      COUNT
+    };
+
+    /**
+     * Decides when a request to the set-top box may be sent so that playback is
+     * never held up by background traffic. Each class has its own concurrency
+     * limit, a request waits while a more important one is waiting and background
+     * requests are held back entirely while a playback request is running.
+     *
+     * The class of a request is taken from the thread making it, see RequestPriorityScope.
+     */
+    class RequestScheduler
+    {
+    public:
+      /**
+       * A slot to send a request in, it is handed back when destroyed
+       */
+      class Ticket
+      {
+      public:
+        Ticket();
+        ~Ticket();
+
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+
+        RequestPriority GetPriority() const { return m_priority; }
+
+      private:
+        RequestPriority m_priority;
+        bool m_scheduled;
+      };
+
+      /**
+       * Returns the singleton instance
+       * @return
+       */
+      static RequestScheduler& GetInstance();
+
+      /**
+       * @return the class of the requests made by the calling thread
+       */
+      static RequestPriority GetCurrentPriority();
+
+    private:
+      RequestScheduler() = default;
+
+      void Acquire(RequestPriority priority);
+      void Release(RequestPriority priority);
+      bool CanRun(RequestPriority priority) const;
+
+      static const std::array<int, static_cast<int>(RequestPriority::COUNT)> CONCURRENCY_LIMITS;
+
+      std::array<int, static_cast<int>(RequestPriority::COUNT)> m_running = {};
+      std::array<int, static_cast<int>(RequestPriority::COUNT)> m_waiting = {};
+      std::mutex m_mutex;
+      std::condition_variable m_condition;
+    };
+
+    /**
+     * Sets the class of the requests made by the current thread for as long as it exists
+     */
+    class RequestPriorityScope
+    {
+    public:
+      explicit RequestPriorityScope(RequestPriority priority);
+      ~RequestPriorityScope();
+
+      RequestPriorityScope(const RequestPriorityScope&) = delete;
+      RequestPriorityScope& operator=(const RequestPriorityScope&) = delete;
+
+    private:
+      RequestPriority m_previousPriority;
+    };
+  } // namespace utilities
+} // namespace enigma2
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#include "SingleFlight.h"
+
+using namespace enigma2;
+using namespace enigma2::utilities;
+
+SingleFlight& SingleFlight::GetInstance()
+{
+  static SingleFlight singleFlight;
+  return singleFlight;
+}
+
+std::string SingleFlight::Do(const std::string& key, int ttlMs, const SingleFlightRequest& request)
+{
+  std::shared_ptr<Flight> flight;
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    RemoveExpiredFlights(std::chrono::steady_clock::now());
+
+    auto flightEntry = m_flights.find(key);
+    if (flightEntry != m_flights.end())
+    {
+      // Hold on to it, the flight is removed from the map once it is done
+      std::shared_ptr<Flight> sharedFlight = flightEntry->second;
+      m_condition.wait(lock, [&sharedFlight] { return sharedFlight->m_done; });
+      return sharedFlight->m_result;
+    }
+
+    flight = std::make_shared<Flight>();
+    m_flights[key] = flight;
+  }
+
+  std::string result = request();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  flight->m_result = result;
+  flight->m_done = true;
+  flight->m_expiry = std::chrono::steady_clock::now() + std::chrono::milliseconds(ttlMs);
+
+  // Failed requests are never handed out again
+  if (ttlMs <= 0 || result.empty())
+    m_flights.erase(key);
+
+  m_condition.notify_all();
+
+  return result;
+}
+
+void SingleFlight::RemoveExpiredFlights(const std::chrono::steady_clock::time_point& now)
+{
+  for (auto it = m_flights.begin(); it != m_flights.end();)
+  {
+    if (it->second->m_done && it->second->m_expiry <= now)
+      it = m_flights.erase(it);
+    else
+      ++it;
+  }
+}
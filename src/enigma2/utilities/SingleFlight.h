@@ -0,0 +1,67 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace enigma2
+{
+  namespace utilities
+  {
+    /**
+     * Short-hand for a function that makes the actual request
+     */
+    typedef std::function<std::string()> SingleFlightRequest;
+
+    /**
+     * Coalesces identical requests. While a request for a key is in flight any
+     * other caller asking for the same key waits for it and gets the same result
+     * instead of sending the request again. The result can optionally be reused
+     * for a short time after the request completed.
+     */
+    class SingleFlight
+    {
+    public:
+      /**
+       * Returns the singleton instance
+       * @return
+       */
+      static SingleFlight& GetInstance();
+
+      /**
+       * Returns the result for the key, only calling request if no identical request is in flight or recently done
+       * @param key identifies the request, e.g. the url
+       * @param ttlMs how long a completed result is handed out for, 0 to only share requests in flight
+       * @param request makes the request
+       */
+      std::string Do(const std::string& key, int ttlMs, const SingleFlightRequest& request);
+
+    private:
+      struct Flight
+      {
+        std::string m_result;
+        bool m_done = false;
+        std::chrono::steady_clock::time_point m_expiry;
+      };
+
+      SingleFlight() = default;
+
+      void RemoveExpiredFlights(const std::chrono::steady_clock::time_point& now);
+
+      std::map<std::string, std::shared_ptr<Flight>> m_flights;
+      std::mutex m_mutex;
+      std::condition_variable m_condition;
+    };
+  } // namespace utilities
+} // namespace enigma2
@@ -10,9 +10,11 @@
 #include "../InstanceSettings.h"
 #include "CurlFile.h"
 #include "Logger.h"
+#include "SingleFlight.h"
 #include "XMLUtils.h"
 
 #include <cctype>
+#include <functional>
 
 #include <kodi/Filesystem.h>
 #include <kodi/tools/StringUtils.h>
@@ -89,7 +91,7 @@ std::string WebUtils::RedactUrl(const std::string& url)
 
 bool WebUtils::CheckHttp(const std::string& url, int connectionTimeoutSecs)
 {
-  Logger::Log(LEVEL_TRACE, "%s Check webAPI with URL: '%s'", __func__, RedactUrl(url).c_str());
+  VUPLUS_LOG(LEVEL_TRACE, "%s Check webAPI with URL: '%s'", __func__, RedactUrl(url).c_str());
 
   CurlFile http;
   if (!http.Check(url, connectionTimeoutSecs))
@@ -98,14 +100,14 @@ bool WebUtils::CheckHttp(const std::string& url, int connectionTimeoutSecs)
     return false;
   }
 
-  Logger::Log(LEVEL_TRACE, "%s WebAPI available", __func__);
+  VUPLUS_LOG(LEVEL_TRACE, "%s WebAPI available", __func__);
 
   return true;
 }
 
 std::string WebUtils::GetHttp(const std::string& url)
 {
-  Logger::Log(LEVEL_DEBUG, "%s Open webAPI with URL: '%s'", __func__, RedactUrl(url).c_str());
+  VUPLUS_LOG(LEVEL_DEBUG, "%s Open webAPI with URL: '%s'", __func__, RedactUrl(url).c_str());
 
   std::string strTmp;
 
@@ -125,17 +127,126 @@ std::string WebUtils::GetHttpXML(const std::string& url)
 {
   std::string strTmp = GetHttp(url);
 
+  AddMissingNewline(strTmp);
+
+  return strTmp;
+}
+
+std::string WebUtils::GetHttpXMLShared(const std::string& url, int ttlMs)
+{
+  return SingleFlight::GetInstance().Do(url, ttlMs, [&url]() { return GetHttpXML(url); });
+}
+
+bool WebUtils::GetHttpXMLIfChanged(const std::string& url, CachedResponse& cachedResponse, std::string& result, bool& unchanged)
+{
+  VUPLUS_LOG(LEVEL_DEBUG, "%s Open webAPI with URL: '%s'", __func__, RedactUrl(url).c_str());
+
+  unchanged = false;
+  result.clear();
+
+  std::string eTag = cachedResponse.m_valid ? cachedResponse.m_eTag : "";
+  std::string lastModified = cachedResponse.m_valid ? cachedResponse.m_lastModified : "";
+  bool notModified = false;
+
+  CurlFile http;
+  if (!http.GetIfModified(url, eTag, lastModified, result, notModified))
+  {
+    Logger::Log(LEVEL_ERROR, "%s - Could not open webAPI.", __func__);
+    result.clear();
+    return false;
+  }
+
+  if (notModified && cachedResponse.m_valid)
+  {
+    Logger::Log(LEVEL_DEBUG, "%s Result not modified", __func__);
+    unchanged = true;
+    return true;
+  }
+
+  // Most endpoints send no validators so compare the body itself
+  if (IsCachedBody(cachedResponse, result))
+  {
+    Logger::Log(LEVEL_DEBUG, "%s Result unchanged. Length: %u", __func__, result.length());
+    unchanged = true;
+    result.clear();
+    return true;
+  }
+
+  cachedResponse.m_eTag = eTag;
+  cachedResponse.m_lastModified = lastModified;
+
+  Logger::Log(LEVEL_DEBUG, "%s Got result. Length: %u", __func__, result.length());
+
+  AddMissingNewline(result);
+
+  return true;
+}
+
+bool WebUtils::GetHttpXMLSharedIfChanged(const std::string& url, int ttlMs, CachedResponse& cachedResponse, std::string& result, bool& unchanged)
+{
+  unchanged = false;
+
+  result = GetHttpXMLShared(url, ttlMs);
+  if (result.empty())
+    return false;
+
+  if (IsCachedBody(cachedResponse, result))
+  {
+    Logger::Log(LEVEL_DEBUG, "%s Result unchanged. Length: %u", __func__, result.length());
+    unchanged = true;
+    result.clear();
+  }
+
+  return true;
+}
+
+bool WebUtils::IsCachedBody(CachedResponse& cachedResponse, const std::string& result)
+{
+  const size_t bodyHash = std::hash<std::string>{}(result);
+  if (cachedResponse.m_valid && cachedResponse.m_bodySize == result.size() && cachedResponse.m_bodyHash == bodyHash)
+    return true;
+
+  cachedResponse.m_bodyHash = bodyHash;
+  cachedResponse.m_bodySize = result.size();
+  cachedResponse.m_eTag.clear();
+  cachedResponse.m_lastModified.clear();
+  cachedResponse.m_valid = true;
+
+  return false;
+}
+
+void WebUtils::AddMissingNewline(std::string& response)
+{
   // If there is no newline add it as it not being there will cause a parse error
   // TODO: Remove once bug is fixed in Open WebIf
-  if (!strTmp.empty() && strTmp.back() != '\n')
-    strTmp += "\n";
+  if (!response.empty() && response.back() != '\n')
+    response += "\n";
+}
 
-  return strTmp;
+bool WebUtils::GetHttpStream(const std::string& url, const CurlDataHandler& dataHandler)
+{
+  VUPLUS_LOG(LEVEL_DEBUG, "%s Open webAPI with URL: '%s'", __func__, RedactUrl(url).c_str());
+
+  size_t length = 0;
+
+  CurlFile http;
+  if (!http.Get(url, [&](const char* data, size_t size) {
+        length += size;
+        return dataHandler(data, size);
+      }))
+  {
+    Logger::Log(LEVEL_ERROR, "%s - Could not open webAPI.", __func__);
+    return false;
+  }
+
+  Logger::Log(LEVEL_DEBUG, "%s Got result. Length: %u", __func__, length);
+
+  return true;
 }
 
 std::string WebUtils::PostHttpJson(const std::string& url)
 {
-  Logger::Log(LEVEL_DEBUG, "%s Open webAPI with URL: '%s'", __func__, RedactUrl(url).c_str());
+  VUPLUS_LOG(LEVEL_DEBUG, "%s Open webAPI with URL: '%s'", __func__, RedactUrl(url).c_str());
 
   std::string strTmp;
 
@@ -146,10 +257,7 @@ std::string WebUtils::PostHttpJson(const std::string& url)
     return "";
   }
 
-  // If there is no newline add it as it not being there will cause a parse error
-  // TODO: Remove once bug is fixed in Open WebIf
-  if (!strTmp.empty() && strTmp.back() != '\n')
-    strTmp += "\n";
+  AddMissingNewline(strTmp);
 
   Logger::Log(LEVEL_DEBUG, "%s Got result. Length: %u", __func__, strTmp.length());
 
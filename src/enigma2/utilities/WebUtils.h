@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include "CurlFile.h"
+
 #include <string>
 
 namespace enigma2
@@ -16,6 +18,20 @@ namespace enigma2
     static const std::string HTTP_PREFIX = "http://";
     static const std::string HTTPS_PREFIX = "https://";
 
+    /**
+     * What is remembered of the last response for a url so an unchanged response can be recognised
+     */
+    struct CachedResponse
+    {
+      size_t m_bodyHash = 0;
+      size_t m_bodySize = 0;
+      std::string m_eTag;
+      std::string m_lastModified;
+      bool m_valid = false;
+
+      void Clear() { *this = CachedResponse(); }
+    };
+
     class WebUtils
     {
     public:
@@ -23,6 +39,10 @@ namespace enigma2
       static bool CheckHttp(const std::string& url, int connectionTimeoutSecs);
       static std::string GetHttp(const std::string& url);
       static std::string GetHttpXML(const std::string& url);
+      static std::string GetHttpXMLShared(const std::string& url, int ttlMs = 0);
+      static bool GetHttpXMLIfChanged(const std::string& url, CachedResponse& cachedResponse, std::string& result, bool& unchanged);
+      static bool GetHttpXMLSharedIfChanged(const std::string& url, int ttlMs, CachedResponse& cachedResponse, std::string& result, bool& unchanged);
+      static bool GetHttpStream(const std::string& url, const CurlDataHandler& dataHandler);
       static std::string PostHttpJson(const std::string& url);
       static bool SendSimpleCommand(const std::string& strCommandURL, const std::string& connectionURL, std::string& strResultText, bool bIgnoreResult = false);
       static bool SendSimpleJsonCommand(const std::string& strCommandURL, const std::string& connectionURL, std::string& strResultText, bool bIgnoreResult = false);
@@ -32,6 +52,18 @@ namespace enigma2
       static std::string ReadFileContentsStartOnly(const std::string& url, int* httpCode);
       static bool IsHttpUrl(const std::string& url);
       static std::string RedactUrl(const std::string& url);
+
+    private:
+      /**
+       * Checks the body against the cached response, remembering it if it differs
+       * @return true if the body is the same as the cached one
+       */
+      static bool IsCachedBody(CachedResponse& cachedResponse, const std::string& result);
+
+      /**
+       * Works around Open WebIf sometimes leaving out the final newline of a response
+       */
+      static void AddMissingNewline(std::string& response);
     };
   } // namespace utilities
 } // namespace enigma2
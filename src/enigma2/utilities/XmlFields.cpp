@@ -0,0 +1,346 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#include "XmlFields.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+using namespace enigma2;
+using namespace enigma2::utilities;
+
+namespace
+{
+
+bool IsWhiteSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool IsNameEnd(char c)
+{
+  return IsWhiteSpace(c) || c == '>' || c == '/';
+}
+
+void AppendUtf8(std::string& value, unsigned long codePoint)
+{
+  if (codePoint < 0x80)
+  {
+    value.push_back(static_cast<char>(codePoint));
+  }
+  else if (codePoint < 0x800)
+  {
+    value.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+    value.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  }
+  else if (codePoint < 0x10000)
+  {
+    value.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+    value.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    value.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  }
+  else if (codePoint < 0x110000)
+  {
+    value.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+    value.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+    value.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    value.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  }
+}
+
+// Decodes a single entity starting at text[pos] == '&', returns the number of characters used
+size_t AppendEntity(std::string& value, std::string_view text, size_t pos)
+{
+  static const struct
+  {
+    std::string_view m_entity;
+    char m_character;
+  } entities[] = {{"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''}};
+
+  for (const auto& entity : entities)
+  {
+    if (text.compare(pos, entity.m_entity.size(), entity.m_entity) == 0)
+    {
+      value.push_back(entity.m_character);
+      return entity.m_entity.size();
+    }
+  }
+
+  size_t endPos = text.find(';', pos);
+  if (text.compare(pos, 2, "&#") == 0 && endPos != std::string_view::npos && endPos - pos < 12)
+  {
+    const bool hex = pos + 2 < text.size() && (text[pos + 2] == 'x' || text[pos + 2] == 'X');
+    unsigned long codePoint = 0;
+    for (size_t i = pos + (hex ? 3 : 2); i < endPos; i++)
+    {
+      char c = text[i];
+      int digit;
+      if (c >= '0' && c <= '9')
+        digit = c - '0';
+      else if (hex && c >= 'a' && c <= 'f')
+        digit = c - 'a' + 10;
+      else if (hex && c >= 'A' && c <= 'F')
+        digit = c - 'A' + 10;
+      else
+        return 0;
+      codePoint = codePoint * (hex ? 16 : 10) + digit;
+    }
+
+    AppendUtf8(value, codePoint);
+    return endPos - pos + 1;
+  }
+
+  return 0;
+}
+
+// Same as atoi, skips leading white space and stops at the first character that is not a digit
+int ParseInt(std::string_view text)
+{
+  size_t pos = 0;
+  while (pos < text.size() && IsWhiteSpace(text[pos]))
+    pos++;
+
+  bool negative = false;
+  if (pos < text.size() && (text[pos] == '-' || text[pos] == '+'))
+    negative = text[pos++] == '-';
+
+  long long value = 0;
+  for (; pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; pos++)
+    value = value * 10 + (text[pos] - '0');
+
+  return static_cast<int>(negative ? -value : value);
+}
+
+} // unnamed namespace
+
+int XmlFieldTable::GetIndex(std::string_view fieldName) const
+{
+  for (size_t i = 0; i < m_fieldNames.size(); i++)
+  {
+    if (m_fieldNames[i] == fieldName)
+      return static_cast<int>(i);
+  }
+
+  return -1;
+}
+
+void XmlFields::Read(std::string_view element)
+{
+  for (auto& field : m_fields)
+    field = Field();
+
+  // Skip the start tag of the element itself
+  size_t pos = element.find('>');
+  if (pos == std::string_view::npos || (pos > 0 && element[pos - 1] == '/'))
+    return;
+  pos++;
+
+  while ((pos = element.find('<', pos)) != std::string_view::npos)
+  {
+    size_t nameStart = pos + 1;
+    if (nameStart >= element.size() || element[nameStart] == '/' || element[nameStart] == '!' || element[nameStart] == '?')
+    {
+      pos = nameStart;
+      continue;
+    }
+
+    size_t nameEnd = nameStart;
+    while (nameEnd < element.size() && !IsNameEnd(element[nameEnd]))
+      nameEnd++;
+
+    size_t tagEnd = element.find('>', nameEnd);
+    if (tagEnd == std::string_view::npos)
+      return;
+
+    const std::string_view name = element.substr(nameStart, nameEnd - nameStart);
+    const bool emptyElement = element[tagEnd - 1] == '/';
+    const std::string_view attributes = element.substr(nameEnd, tagEnd - nameEnd - (emptyElement ? 1 : 0));
+
+    size_t valueEnd = tagEnd + 1;
+    std::string_view value;
+    if (!emptyElement)
+    {
+      // The closing tag is matched by name so any nested elements end up in the value
+      size_t closePos = tagEnd + 1;
+      while ((closePos = element.find("</", closePos)) != std::string_view::npos)
+      {
+        if (element.compare(closePos + 2, name.size(), name) == 0 && closePos + 2 + name.size() < element.size() &&
+            (element[closePos + 2 + name.size()] == '>' || IsWhiteSpace(element[closePos + 2 + name.size()])))
+          break;
+        closePos += 2;
+      }
+      if (closePos == std::string_view::npos)
+        return;
+
+      value = element.substr(tagEnd + 1, closePos - tagEnd - 1);
+      valueEnd = element.find('>', closePos);
+      if (valueEnd == std::string_view::npos)
+        return;
+      valueEnd++;
+    }
+
+    // Only the first occurrence counts, the same as FirstChildElement()
+    int index = m_fieldTable.GetIndex(name);
+    if (index >= 0 && !m_fields[index].m_present)
+    {
+      m_fields[index].m_value = value;
+      m_fields[index].m_attributes = attributes;
+      m_fields[index].m_present = true;
+    }
+
+    pos = valueEnd;
+  }
+}
+
+const XmlFields::Field* XmlFields::FindField(std::string_view fieldName) const
+{
+  int index = m_fieldTable.GetIndex(fieldName);
+  if (index < 0 || !m_fields[index].m_present)
+    return nullptr;
+
+  return &m_fields[index];
+}
+
+std::string_view XmlFields::GetRawValue(std::string_view fieldName) const
+{
+  const Field* field = FindField(fieldName);
+  return field ? field->m_value : std::string_view();
+}
+
+bool XmlFields::GetString(std::string_view fieldName, std::string& value) const
+{
+  value.clear();
+
+  const Field* field = FindField(fieldName);
+  if (!field)
+    return false;
+
+  const std::string_view text = field->m_value;
+  value.reserve(text.size());
+
+  // Leading and trailing white space is dropped and runs of white space become a single space
+  bool pendingSpace = false;
+  for (size_t pos = 0; pos < text.size(); pos++)
+  {
+    char c = text[pos];
+    if (IsWhiteSpace(c))
+    {
+      pendingSpace = !value.empty();
+      continue;
+    }
+
+    if (pendingSpace)
+    {
+      value.push_back(' ');
+      pendingSpace = false;
+    }
+
+    size_t entitySize = 0;
+    if (c == '&')
+      entitySize = AppendEntity(value, text, pos);
+
+    if (entitySize > 0)
+      pos += entitySize - 1;
+    else
+      value.push_back(c);
+  }
+
+  return !value.empty();
+}
+
+bool XmlFields::GetInt(std::string_view fieldName, int& value) const
+{
+  const Field* field = FindField(fieldName);
+  if (!field || field->m_value.empty())
+    return false;
+
+  value = ParseInt(field->m_value);
+  return true;
+}
+
+bool XmlFields::GetDouble(std::string_view fieldName, double& value) const
+{
+  const Field* field = FindField(fieldName);
+  if (!field || field->m_value.empty())
+    return false;
+
+  // atof needs a terminated string, numbers are short enough for a small buffer
+  char buffer[64];
+  const size_t size = std::min(field->m_value.size(), sizeof(buffer) - 1);
+  std::memcpy(buffer, field->m_value.data(), size);
+  buffer[size] = '\0';
+
+  value = std::atof(buffer);
+  return true;
+}
+
+bool XmlFields::GetBoolean(std::string_view fieldName, bool& value) const
+{
+  std::string text;
+  if (!GetString(fieldName, text))
+    return false;
+
+  std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+  if (text == "off" || text == "no" || text == "disabled" || text == "false" || text == "0")
+  {
+    value = false;
+  }
+  else
+  {
+    value = true;
+    if (text != "on" && text != "yes" && text != "enabled" && text != "true")
+      return false; // invalid bool switch - it's probably some other string.
+  }
+
+  return true;
+}
+
+bool XmlFields::GetIntAttribute(std::string_view fieldName, std::string_view attributeName, int& value) const
+{
+  const Field* field = FindField(fieldName);
+  if (!field)
+    return false;
+
+  const std::string_view attributes = field->m_attributes;
+  size_t pos = 0;
+  while ((pos = attributes.find(attributeName, pos)) != std::string_view::npos)
+  {
+    size_t valuePos = pos + attributeName.size();
+    const bool nameStart = pos == 0 || IsWhiteSpace(attributes[pos - 1]);
+
+    while (valuePos < attributes.size() && IsWhiteSpace(attributes[valuePos]))
+      valuePos++;
+
+    if (nameStart && valuePos < attributes.size() && attributes[valuePos] == '=')
+    {
+      valuePos++;
+      while (valuePos < attributes.size() && IsWhiteSpace(attributes[valuePos]))
+        valuePos++;
+
+      if (valuePos < attributes.size() && (attributes[valuePos] == '"' || attributes[valuePos] == '\''))
+      {
+        const char quote = attributes[valuePos];
+        const size_t valueEnd = attributes.find(quote, valuePos + 1);
+        if (valueEnd == std::string_view::npos)
+          return false;
+
+        const std::string_view attributeValue = attributes.substr(valuePos + 1, valueEnd - valuePos - 1);
+        if (attributeValue.empty() || !(std::isdigit(static_cast<unsigned char>(attributeValue[0])) || attributeValue[0] == '-'))
+          return false;
+
+        value = ParseInt(attributeValue);
+        return true;
+      }
+    }
+
+    pos += attributeName.size();
+  }
+
+  return false;
+}
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#pragma once
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace enigma2
+{
+  namespace utilities
+  {
+    /**
+     * The child elements used for one type of e2 element, e.g. e2event. Only
+     * these are picked out when an element is read, everything else is skipped.
+     */
+    class XmlFieldTable
+    {
+    public:
+      XmlFieldTable(std::initializer_list<std::string_view> fieldNames) : m_fieldNames(fieldNames) {}
+
+      int GetIndex(std::string_view fieldName) const;
+      size_t GetSize() const { return m_fieldNames.size(); }
+
+    private:
+      std::vector<std::string_view> m_fieldNames;
+    };
+
+    /**
+     * The fields of a single e2 element as slices of the response buffer. Nothing
+     * is copied or decoded until a value is actually requested, and reading the
+     * next element reuses the same slots so there are no allocations per element.
+     */
+    class XmlFields
+    {
+    public:
+      XmlFields(const XmlFieldTable& fieldTable) : m_fieldTable(fieldTable), m_fields(fieldTable.GetSize()) {}
+
+      /**
+       * Picks the fields out of the raw text of an element, the views are only valid while the text is
+       */
+      void Read(std::string_view element);
+
+      /**
+       * @return the raw text of the field or an empty view if not present
+       */
+      std::string_view GetRawValue(std::string_view fieldName) const;
+
+      /**
+       * Decodes entities and condenses white space in the same way as TinyXML
+       * @return false if the field is missing or empty, value is cleared in that case
+       */
+      bool GetString(std::string_view fieldName, std::string& value) const;
+      bool GetInt(std::string_view fieldName, int& value) const;
+      bool GetDouble(std::string_view fieldName, double& value) const;
+      bool GetBoolean(std::string_view fieldName, bool& value) const;
+      bool GetIntAttribute(std::string_view fieldName, std::string_view attributeName, int& value) const;
+
+    private:
+      struct Field
+      {
+        std::string_view m_value;
+        std::string_view m_attributes;
+        bool m_present = false;
+      };
+
+      const Field* FindField(std::string_view fieldName) const;
+
+      const XmlFieldTable& m_fieldTable;
+      std::vector<Field> m_fields;
+    };
+  } // namespace utilities
+} // namespace enigma2
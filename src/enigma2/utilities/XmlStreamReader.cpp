@@ -0,0 +1,110 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#include "XmlStreamReader.h"
+
+#include <algorithm>
+
+using namespace enigma2;
+using namespace enigma2::utilities;
+
+XmlStreamReader::XmlStreamReader(const std::string& listElementName, const std::string& elementName, const XmlElementHandler& handler)
+  : m_listStartTag("<" + listElementName), m_startTag("<" + elementName), m_endTag("</" + elementName + ">"), m_handler(handler)
+{
+}
+
+bool XmlStreamReader::AddData(const char* data, size_t size)
+{
+  if (m_stopped)
+    return false;
+
+  m_buffer.append(data, size);
+
+  while (!m_stopped)
+  {
+    if (!m_inElement)
+    {
+      if (!m_foundListElement && FindStartTag(m_listStartTag, m_scanPos) != std::string::npos)
+        m_foundListElement = true;
+
+      size_t startPos = FindStartTag(m_startTag, m_scanPos);
+      if (startPos == std::string::npos)
+      {
+        // Nothing of interest so far, only keep enough to match a tag split across two chunks
+        size_t keepSize = std::max(m_listStartTag.size(), m_startTag.size());
+        if (m_buffer.size() > m_startPos + keepSize)
+          m_startPos = m_buffer.size() - keepSize;
+        m_scanPos = m_startPos;
+        break;
+      }
+
+      m_startPos = startPos;
+      m_scanPos = startPos + m_startTag.size();
+      m_inElement = true;
+    }
+
+    size_t tagEndPos = m_buffer.find('>', m_startPos + m_startTag.size());
+    if (tagEndPos == std::string::npos)
+      break;
+
+    if (m_buffer[tagEndPos - 1] == '/') // empty element
+    {
+      ReadElement(tagEndPos + 1);
+      continue;
+    }
+
+    size_t endPos = m_buffer.find(m_endTag, std::max(m_scanPos, tagEndPos));
+    if (endPos == std::string::npos)
+    {
+      // The end tag could be split across two chunks
+      if (m_buffer.size() >= m_startPos + m_endTag.size())
+        m_scanPos = m_buffer.size() - m_endTag.size() + 1;
+      break;
+    }
+
+    ReadElement(endPos + m_endTag.size());
+  }
+
+  // Drop what has been consumed once per chunk instead of once per element
+  m_buffer.erase(0, m_startPos);
+  m_scanPos -= m_startPos;
+  m_startPos = 0;
+
+  return !m_stopped;
+}
+
+size_t XmlStreamReader::FindStartTag(const std::string& startTag, size_t startPos) const
+{
+  size_t pos = startPos;
+  while ((pos = m_buffer.find(startTag, pos)) != std::string::npos)
+  {
+    // Make sure it is the whole name, i.e. <e2event but not <e2eventlist
+    size_t nextPos = pos + startTag.size();
+    if (nextPos >= m_buffer.size())
+      return std::string::npos;
+
+    char next = m_buffer[nextPos];
+    if (next == '>' || next == '/' || next == ' ' || next == '\t' || next == '\r' || next == '\n')
+      return pos;
+
+    pos = nextPos;
+  }
+
+  return std::string::npos;
+}
+
+void XmlStreamReader::ReadElement(size_t endPos)
+{
+  m_elementCount++;
+
+  if (!m_handler(std::string_view(m_buffer.data() + m_startPos, endPos - m_startPos)))
+    m_stopped = true;
+
+  m_startPos = endPos;
+  m_scanPos = endPos;
+  m_inElement = false;
+}
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace enigma2
+{
+  namespace utilities
+  {
+    /**
+     * Short-hand for a function that is called with the raw text of each complete element, return false to stop reading.
+     * The text is only valid for the duration of the call.
+     */
+    typedef std::function<bool(std::string_view element)> XmlElementHandler;
+
+    /**
+     * Pull parser for the e2 list responses, e.g. <e2eventlist> containing
+     * <e2event> elements. Data is added as it arrives and each repeating element
+     * is handed out as soon as it is complete, so only a single element is ever
+     * held in memory instead of a DOM for the whole response.
+     */
+    class XmlStreamReader
+    {
+    public:
+      XmlStreamReader(const std::string& listElementName, const std::string& elementName, const XmlElementHandler& handler);
+
+      /**
+       * Adds the next chunk of the response
+       * @return false if the handler asked to stop reading
+       */
+      bool AddData(const char* data, size_t size);
+
+      bool FoundListElement() const { return m_foundListElement; }
+      int GetElementCount() const { return m_elementCount; }
+
+    private:
+      size_t FindStartTag(const std::string& elementName, size_t startPos) const;
+      void ReadElement(size_t endPos);
+
+      std::string m_listStartTag;
+      std::string m_startTag;
+      std::string m_endTag;
+      XmlElementHandler m_handler;
+
+      std::string m_buffer;
+      // start of the data in the buffer which has not been consumed yet
+      size_t m_startPos = 0;
+      size_t m_scanPos = 0;
+      bool m_inElement = false;
+      bool m_stopped = false;
+      bool m_foundListElement = false;
+      int m_elementCount = 0;
+    };
+  } // namespace utilities
+} // namespace enigma2
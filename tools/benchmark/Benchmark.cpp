@@ -0,0 +1,233 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSE.md for more information.
+ */
+
+/*
+ * Micro benchmarks of the parsing and mapping hot paths. Only code which runs
+ * without Kodi is covered. EpgEntry and RecordingEntry::UpdateFrom are not, as
+ * they need an InstanceSettings, which reads every value from Kodi when it is
+ * constructed. Build with -DVUPLUS_BUILD_BENCHMARKS=ON
+ * and run vuplus-benchmark, optionally with a part of the benchmark names to
+ * run only those.
+ */
+
+#include "enigma2/data/Channel.h"
+#include "enigma2/data/Tags.h"
+#include "enigma2/utilities/WebUtils.h"
+#include "enigma2/utilities/XmlFields.h"
+#include "enigma2/utilities/XmlStreamReader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <kodi/AddonBase.h>
+
+using namespace enigma2::data;
+using namespace enigma2::utilities;
+
+// The add-on sources call into Kodi through the interface set up by
+// ADDONCREATOR, none of the benchmarked functions use it
+class ATTR_DLL_LOCAL CBenchmarkAddon : public kodi::addon::CAddonBase
+{
+};
+
+ADDONCREATOR(CBenchmarkAddon)
+
+namespace
+{
+
+struct Benchmark
+{
+  std::string m_name;
+  // number of entries handled by one call, to report the cost per entry
+  int m_items;
+  std::function<size_t()> m_function;
+};
+
+const std::chrono::milliseconds MIN_RUN_TIME(500);
+const size_t CHUNK_SIZE = 16 * 1024;
+const int LIST_SIZE = 1000;
+
+// results are summed up here so the compiler can not drop the benchmarked calls
+volatile size_t g_sink = 0;
+
+void Run(const Benchmark& benchmark)
+{
+  // warm up caches and the lazily built tables
+  g_sink = g_sink + benchmark.m_function();
+
+  size_t iterations = 1;
+  while (true)
+  {
+    size_t sink = 0;
+    const auto started = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+      sink += benchmark.m_function();
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+    g_sink = g_sink + sink;
+
+    if (elapsed >= MIN_RUN_TIME)
+    {
+      double nanoseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / iterations;
+      std::printf("%-48s %14.1f ns %12zu", benchmark.m_name.c_str(), nanoseconds, iterations);
+      if (benchmark.m_items > 1)
+        std::printf(" %12.1f ns/entry", nanoseconds / benchmark.m_items);
+      std::printf("\n");
+      return;
+    }
+
+    iterations *= elapsed < MIN_RUN_TIME / 10 ? 10 : 2;
+  }
+}
+
+std::string MakeEvent(int index)
+{
+  return "<e2event>\n"
+         "  <e2eventid>" + std::to_string(1000 + index) + "</e2eventid>\n"
+         "  <e2eventstart>" + std::to_string(1622534400 + index * 1800) + "</e2eventstart>\n"
+         "  <e2eventduration>1800</e2eventduration>\n"
+         "  <e2eventcurrenttime>1622534400</e2eventcurrenttime>\n"
+         "  <e2eventtitle>Gardeners&apos; World</e2eventtitle>\n"
+         "  <e2eventdescription>New series. (S12E4)</e2eventdescription>\n"
+         "  <e2eventdescriptionextended>Monty Don visits a garden in the Cotswolds and shows how to plant\n"
+         "    a border for late summer colour. [S] [HD]</e2eventdescriptionextended>\n"
+         "  <e2eventgenre id=\"160\">Leisure hobbies</e2eventgenre>\n"
+         "  <e2eventservicereference>1:0:19:2B5C:3F3:1:C00000:0:0:0:</e2eventservicereference>\n"
+         "  <e2eventservicename>BBC Two HD</e2eventservicename>\n"
+         "</e2event>\n";
+}
+
+std::string MakeMovie(int index)
+{
+  const std::string filename = "/media/hdd/movie/20210531 2000 - BBC One HD - EastEnders_" + std::to_string(index) + ".ts";
+  return "<e2movie>\n"
+         "  <e2servicereference>1:0:0:0:0:0:0:0:0:0:" + filename + "</e2servicereference>\n"
+         "  <e2title>EastEnders</e2title>\n"
+         "  <e2description>Episode (S37E" + std::to_string(index % 200) + ")</e2description>\n"
+         "  <e2descriptionextended>Drama set in the East End of London. Sharon &amp; Phil have a row.</e2descriptionextended>\n"
+         "  <e2servicename>BBC One HD</e2servicename>\n"
+         "  <e2time>" + std::to_string(1622487600 - index * 86400) + "</e2time>\n"
+         "  <e2length>29:47</e2length>\n"
+         "  <e2tags>GenreId=0x30 AutoTimer EastEnders Padding=3,5</e2tags>\n"
+         "  <e2filename>" + filename + "</e2filename>\n"
+         "  <e2filesize>1510000000</e2filesize>\n"
+         "</e2movie>\n";
+}
+
+std::string MakeList(const char* listElement, const std::function<std::string(int)>& makeElement)
+{
+  std::string list = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<" + std::string(listElement) + ">\n";
+  for (int i = 0; i < LIST_SIZE; i++)
+    list += makeElement(i);
+  list += "</" + std::string(listElement) + ">\n";
+
+  return list;
+}
+
+size_t ReadEventFields(const XmlFields& fields)
+{
+  std::string title;
+  std::string plot;
+  std::string plotOutline;
+  int start = 0;
+  int duration = 0;
+  int genreId = 0;
+
+  fields.GetInt("e2eventstart", start);
+  fields.GetInt("e2eventduration", duration);
+  fields.GetString("e2eventtitle", title);
+  fields.GetString("e2eventdescriptionextended", plot);
+  fields.GetString("e2eventdescription", plotOutline);
+  fields.GetIntAttribute("e2eventgenre", "id", genreId);
+
+  return title.size() + plot.size() + plotOutline.size() + start + duration + genreId;
+}
+
+size_t ReadList(const std::string& list, const char* listElement, const char* element, XmlFields& fields,
+                const std::function<size_t(const XmlFields&)>& readFields)
+{
+  size_t sink = 0;
+  XmlStreamReader reader(listElement, element, [&](std::string_view text) {
+    fields.Read(text);
+    sink += readFields(fields);
+    return true;
+  });
+
+  // feed the response in the chunks it arrives in from the network
+  for (size_t pos = 0; pos < list.size(); pos += CHUNK_SIZE)
+    reader.AddData(list.data() + pos, std::min(CHUNK_SIZE, list.size() - pos));
+
+  return sink + reader.GetElementCount();
+}
+
+} // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+  const char* filter = argc > 1 ? argv[1] : nullptr;
+
+  const std::string bouquetReference = "1:7:1:0:0:0:0:0:0:0:FROM BOUQUET \"userbouquet.favourites.tv\" ORDER BY bouquet";
+  const std::string recordingFilename = "/media/hdd/movie/20210531 2000 - BBC One HD - EastEnders.ts";
+  const std::string serviceReference = "1:0:19:2B5C:3F3:1:C00000:0:0:0:http%3a//10.0.0.5%3a8001/1%3a0%3a19%3a2B5C%3a3F3%3a1%3aC00000%3a0%3a0%3a0%3a:BBC Two HD";
+  const std::string commonServiceReference = Channel::CreateCommonServiceReference(serviceReference);
+  const Tags tags("GenreId=0x30 AutoTimer EastEnders Padding=3,5 Play=2");
+
+  const XmlFieldTable eventFieldTable{"e2eventid", "e2eventstart", "e2eventduration", "e2eventtitle", "e2eventdescription",
+                                      "e2eventdescriptionextended", "e2eventgenre", "e2eventservicereference"};
+  const XmlFieldTable movieFieldTable{"e2servicereference", "e2title", "e2description", "e2descriptionextended", "e2servicename",
+                                      "e2time", "e2length", "e2tags", "e2filename", "e2filesize"};
+  XmlFields eventFields(eventFieldTable);
+  XmlFields movieFields(movieFieldTable);
+
+  const std::string event = MakeEvent(0);
+  const std::string eventList = MakeList("e2eventlist", MakeEvent);
+  const std::string movieList = MakeList("e2movielist", MakeMovie);
+
+  const std::vector<Benchmark> benchmarks = {
+    {"WebUtils::URLEncodeInline/BouquetReference", 1, [&]() { return WebUtils::URLEncodeInline(bouquetReference).size(); }},
+    {"WebUtils::URLEncodeInline/RecordingFilename", 1, [&]() { return WebUtils::URLEncodeInline(recordingFilename).size(); }},
+    {"Channel::NormaliseServiceReference/Standard", 1, [&]() { return Channel::NormaliseServiceReference(serviceReference, true).size(); }},
+    {"Channel::NormaliseServiceReference/AsIs", 1, [&]() { return Channel::NormaliseServiceReference(serviceReference, false).size(); }},
+    {"Channel::CreateStandardServiceReference", 1, [&]() { return Channel::CreateStandardServiceReference(serviceReference).size(); }},
+    {"Channel::CreateCommonServiceReference", 1, [&]() { return Channel::CreateCommonServiceReference(serviceReference).size(); }},
+    {"Channel::CreateGenericServiceReference", 1, [&]() { return Channel::CreateGenericServiceReference(commonServiceReference).size(); }},
+    {"Tags::ContainsTag/Present", 1, [&]() { return static_cast<size_t>(tags.ContainsTag("Padding")); }},
+    {"Tags::ContainsTag/Missing", 1, [&]() { return static_cast<size_t>(tags.ContainsTag("ChannelRef")); }},
+    {"Tags::RemoveTag/WithValue", 1, [&]() { Tags copy = tags; copy.RemoveTag("Padding"); return copy.GetTags().size(); }},
+    {"Tags::RemoveTag/Missing", 1, [&]() { Tags copy = tags; copy.RemoveTag("ChannelRef"); return copy.GetTags().size(); }},
+    {"XmlFields::Read/Event", 1, [&]() { eventFields.Read(event); return eventFields.GetRawValue("e2eventtitle").size(); }},
+    {"XmlFields::Read+Get/Event", 1, [&]() { eventFields.Read(event); return ReadEventFields(eventFields); }},
+    {"XmlStreamReader/EventList", LIST_SIZE, [&]() {
+      return ReadList(eventList, "e2eventlist", "e2event", eventFields, ReadEventFields);
+    }},
+    {"XmlStreamReader/MovieList", LIST_SIZE, [&]() {
+      return ReadList(movieList, "e2movielist", "e2movie", movieFields, [](const XmlFields& fields) {
+        std::string title;
+        std::string tags;
+        std::string filename;
+        double size = 0;
+        fields.GetString("e2title", title);
+        fields.GetString("e2tags", tags);
+        fields.GetString("e2filename", filename);
+        fields.GetDouble("e2filesize", size);
+        return title.size() + tags.size() + filename.size() + static_cast<size_t>(size);
+      });
+    }},
+  };
+
+  std::printf("%-48s %17s %12s\n", "Benchmark", "Time", "Iterations");
+  for (const auto& benchmark : benchmarks)
+  {
+    if (!filter || benchmark.m_name.find(filter) != std::string::npos)
+      Run(benchmark);
+  }
+
+  return 0;
+}
@@ -0,0 +1,360 @@
+#!/usr/bin/env python3
+#
+#  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+#
+#  SPDX-License-Identifier: GPL-2.0-or-later
+#  See LICENSE.md for more information.
+#
+
+"""
+Generates a scaled OpenWebIf fixture set for mock_openwebif.py.
+
+Every dimension has its own knob so load times can be compared as one of them
+grows. The output uses the same layout as the bundled fixtures. Device info,
+settings and other small responses are copied from the bundled fixtures. EPG
+and timer times are relative to the time of generation so the data is current
+when loaded. The same seed always produces the same data for the same knobs.
+"""
+
+import argparse
+import json
+import os
+import random
+import shutil
+import sys
+import time
+from xml.sax.saxutils import escape
+
+from mock_openwebif import fixture_name
+
+# size of the worst installations seen in the wild
+LARGE = {
+  "channels": 4000,
+  "radio_channels": 400,
+  "bouquets": 60,
+  "epg_days": 14,
+  "recordings": 25000,
+  "locations": 8,
+  "timers": 800,
+  "autotimers": 100,
+}
+
+DEFAULT = {
+  "channels": 400,
+  "radio_channels": 40,
+  "bouquets": 20,
+  "epg_days": 7,
+  "recordings": 2500,
+  "locations": 4,
+  "timers": 100,
+  "autotimers": 20,
+}
+
+STATIC_FIXTURES = [
+  ("web/deviceinfo", {}),
+  ("web/currenttime", {}),
+  ("web/signal", {}),
+  ("web/settings", {}),
+  ("autotimer/get", {}),
+  ("api/deviceinfo", {}),
+]
+
+XML_HEADER = '<?xml version="1.0" encoding="UTF-8"?>\n'
+
+DEFAULT_LOCATION = "/media/hdd/movie/"
+LOCATION_NAMES = ["Series", "Films", "Kids", "Documentaries", "Sport", "Music", "Archive", "Drama", "Comedy", "News"]
+
+TITLES = ["News", "Weather", "Breakfast", "EastEnders", "Coronation Street", "Emmerdale", "Doctor Who",
+          "Match of the Day", "Top Gear", "University Challenge", "Panorama", "Question Time", "Newsnight",
+          "Countryfile", "Antiques Roadshow", "Gardeners' World", "Grand Designs", "Bake Off", "Pointless",
+          "The Chase", "Homes Under the Hammer", "Bargain Hunt", "Line of Duty", "Vera", "Midsomer Murders",
+          "Planet Earth", "Horizon", "Film: The Great Escape", "Film: Casablanca", "Formula 1: Qualifying"]
+
+DESCRIPTIONS = ["The latest national and international news.",
+                "A look at the weather for the week ahead.",
+                "New series. Drama following the lives of the residents.",
+                "Highlights of the day's matches with analysis from the studio.",
+                "Documentary series exploring the natural world.",
+                "Contestants compete for a cash prize.",
+                "Classic film from the archives.",
+                "[S] [HD] Subtitled and in high definition."]
+
+# DVB content nibbles as used in the e2eventgenre id attribute
+GENRE_IDS = [0x10, 0x14, 0x20, 0x23, 0x30, 0x40, 0x43, 0x50, 0x60, 0x70, 0x90, 0xA0]
+
+EVENT_LENGTHS_MINS = [5, 15, 25, 30, 30, 45, 60, 60, 60, 90, 120]
+
+
+def bouquet_reference(filename):
+  return '1:7:1:0:0:0:0:0:0:0:FROM BOUQUET "%s" ORDER BY bouquet' % filename
+
+
+def channel_reference(index, radio):
+  service_type = 2 if radio else 0x19
+  return "1:0:%X:%X:%X:%X:%X:0:0:0:" % (service_type, index + 1, 0x400 + index // 20, 0x2 if radio else 0x1, 0xC00000)
+
+
+class Generator:
+  def __init__(self, args):
+    self.args = args
+    self.random = random.Random(args.seed)
+    self.now = int(time.time()) if args.start is None else args.start
+    self.written_files = 0
+    self.written_bytes = 0
+
+  def open(self, path, query):
+    name = os.path.join(self.args.out, fixture_name(path, query))
+    os.makedirs(os.path.dirname(name), exist_ok=True)
+    self.written_files += 1
+    return open(name, "w", encoding="utf-8")
+
+  def write(self, path, query, body):
+    with self.open(path, query) as f:
+      f.write(body)
+      self.written_bytes += len(body)
+
+  def run(self):
+    self.copy_static_fixtures()
+
+    tv_bouquets = self.generate_channels(self.args.channels, self.args.bouquets, radio=False)
+    radio_bouquets = self.generate_channels(self.args.radio_channels, max(1, self.args.bouquets // 10) if self.args.radio_channels else 0, radio=True)
+    self.generate_epg(tv_bouquets)
+    self.generate_recordings()
+
+    channels = [channel for _, _, bouquet in tv_bouquets for channel in bouquet]
+    self.generate_timers(channels)
+    self.generate_autotimers(channels)
+
+    sys.stderr.write("Wrote %d files, %.1f MB to %s\n" % (self.written_files, self.written_bytes / 1e6, self.args.out))
+
+  def copy_static_fixtures(self):
+    for path, query in STATIC_FIXTURES:
+      name = fixture_name(path, query)
+      target = os.path.join(self.args.out, name)
+      os.makedirs(os.path.dirname(target), exist_ok=True)
+      shutil.copyfile(os.path.join(self.args.template, name), target)
+      self.written_files += 1
+
+  def generate_channels(self, count, bouquet_count, radio):
+    """Spreads the channels over the bouquets, returns (filename, name, channels) for each bouquet"""
+    kind = "radio" if radio else "tv"
+    bouquets = []
+    for i in range(bouquet_count):
+      filename = "userbouquet.favourites.%s" % kind if i == 0 else "userbouquet.group%d.%s" % (i, kind)
+      name = "Favourites (%s)" % ("Radio" if radio else "TV") if i == 0 else "Group %d" % i
+      bouquets.append((filename, name, []))
+
+    for i in range(count if bouquets else 0):
+      name = "%s %d%s" % ("Radio" if radio else "Channel", i + 1, "" if radio or i % 3 else " HD")
+      bouquets[i * bouquet_count // count][2].append((channel_reference(i + (100000 if radio else 0), radio), name))
+
+    root = bouquet_reference("bouquets.%s" % kind)
+    self.write("web/getservices", {"sRef": [root]}, service_list([(bouquet_reference(f), n) for f, n, _ in bouquets]))
+
+    services = []
+    position = 1
+    for filename, name, channels in bouquets:
+      # a marker at the top of the bouquet like most settings lists have
+      entries = [("1:64:%d:0:0:0:0:0:0:0::%s" % (len(services) + 1, name), name)] + channels
+      self.write("web/getservices", {"sRef": [bouquet_reference(filename)]}, service_list(entries))
+
+      services.append({"servicereference": bouquet_reference(filename), "servicename": name, "startpos": position})
+      position += len(channels)
+
+    query = {"sRef": [root]} if radio else {}
+    self.write("api/getservices", query, json.dumps({"services": services, "pos": 0, "result": True}, indent=2) + "\n")
+
+    return bouquets
+
+  def generate_epg(self, bouquets):
+    start = self.now - self.now % 3600 - 3600
+    end = start + self.args.epg_days * 24 * 3600
+    event_id = 1
+
+    for filename, _, channels in bouquets:
+      with self.open("web/epgbouquet", {"bRef": [bouquet_reference(filename)]}) as bouquet_file:
+        bouquet_file.write(XML_HEADER + "<e2eventlist>\n")
+
+        for reference, name in channels:
+          events = []
+          event_start = start
+          while event_start < end:
+            duration = self.random.choice(EVENT_LENGTHS_MINS) * 60
+            title = self.random.choice(TITLES)
+            description = self.random.choice(DESCRIPTIONS)
+            events.append(xml_element("e2event", [
+              ("e2eventid", event_id),
+              ("e2eventstart", event_start),
+              ("e2eventduration", duration),
+              ("e2eventcurrenttime", self.now),
+              ("e2eventtitle", title),
+              ("e2eventdescription", "%s (S%dE%d)" % (title, self.random.randint(1, 12), self.random.randint(1, 20))),
+              ("e2eventdescriptionextended", description),
+              ('e2eventgenre id="%d"' % self.random.choice(GENRE_IDS), "Genre"),
+              ("e2eventservicereference", reference),
+              ("e2eventservicename", name),
+            ]))
+            event_id = event_id % 65535 + 1
+            event_start += duration
+
+          body = "".join(events)
+          bouquet_file.write(body)
+          self.written_bytes += len(body)
+
+          if not self.args.no_epgservice:
+            self.write("web/epgservice", {"sRef": [reference]}, XML_HEADER + "<e2eventlist>\n" + body + "</e2eventlist>\n")
+
+        bouquet_file.write("</e2eventlist>\n")
+
+  def generate_recordings(self):
+    locations = [DEFAULT_LOCATION]
+    for i in range(1, self.args.locations):
+      folder = LOCATION_NAMES[(i - 1) % len(LOCATION_NAMES)]
+      if i > len(LOCATION_NAMES):
+        folder += " %d" % (i // len(LOCATION_NAMES) + 1)
+      locations.append("%s%s/" % (DEFAULT_LOCATION, folder))
+
+    location_list = XML_HEADER + "<e2locations>\n" + "".join("  <e2location>%s</e2location>\n" % escape(l) for l in locations) + "</e2locations>\n"
+    self.write("web/getlocations", {}, location_list)
+    self.write("web/getcurrlocation", {}, XML_HEADER + "<e2locations>\n  <e2location>%s</e2location>\n</e2locations>\n" % escape(DEFAULT_LOCATION))
+
+    movies = [[] for _ in locations]
+    for i in range(self.args.recordings):
+      location = self.random.randrange(len(locations))
+      movies[location].append(self.recording(i, locations[location]))
+
+    for location, entries in zip(locations, movies):
+      body = XML_HEADER + "<e2movielist>\n" + "".join(entries) + "</e2movielist>\n"
+      self.write("web/movielist", {"dirname": [location]}, body)
+      if location == DEFAULT_LOCATION:
+        self.write("web/movielist", {}, body)
+
+      # the deleted items of each location, kept empty so they are not taken from the fallback
+      self.write("web/movielist", {"dirname": [location + ".Trash"]}, XML_HEADER + "<e2movielist>\n</e2movielist>\n")
+
+  def recording(self, index, location):
+    title = self.random.choice(TITLES)
+    channel = "Channel %d HD" % self.random.randint(1, max(1, self.args.channels))
+    start = self.now - self.random.randint(3600, 2 * 365 * 24 * 3600)
+    length = self.random.choice(EVENT_LENGTHS_MINS) * 60 + self.random.randint(0, 59)
+    filename = "%s%s - %s - %s_%d.ts" % (location, time.strftime("%Y%m%d %H%M", time.gmtime(start)), channel, title.replace(":", ""), index)
+
+    tags = []
+    if self.random.random() < 0.6:
+      tags.append("GenreId=0x%X" % self.random.choice(GENRE_IDS))
+    if self.random.random() < 0.3:
+      tags.append("AutoTimer")
+      tags.append(title.replace(" ", "_"))
+    if self.random.random() < 0.2:
+      tags.append("Padding=3,5")
+    if self.random.random() < 0.1:
+      tags.append("Play=%d" % self.random.randint(1, 5))
+
+    return xml_element("e2movie", [
+      ("e2servicereference", "1:0:0:0:0:0:0:0:0:0:" + filename),
+      ("e2title", title),
+      ("e2description", "%s (S%dE%d)" % (title, self.random.randint(1, 12), self.random.randint(1, 20))),
+      ("e2descriptionextended", self.random.choice(DESCRIPTIONS)),
+      ("e2servicename", channel),
+      ("e2time", start),
+      ("e2length", "%d:%02d" % (length // 60, length % 60)),
+      ("e2tags", " ".join(tags)),
+      ("e2filename", filename),
+      ("e2filesize", length * 1000000),
+    ])
+
+  def generate_timers(self, channels):
+    timers = []
+    for i in range(self.args.timers):
+      reference, name = self.random.choice(channels)
+      start = self.now - self.now % 300 + self.random.randint(0, self.args.epg_days * 24 * 12) * 300
+      duration = self.random.choice(EVENT_LENGTHS_MINS) * 60
+      repeating = self.random.random() < 0.15
+      tags = "Padding=3,5" if self.random.random() < 0.5 else ""
+      if not repeating and self.random.random() < 0.3:
+        tags = (tags + " AutoTimer").strip()
+
+      timers.append(xml_element("e2timer", [
+        ("e2servicereference", reference),
+        ("e2servicename", name),
+        ("e2eit", -1 if repeating else i + 1),
+        ("e2name", self.random.choice(TITLES)),
+        ("e2description", ""),
+        ("e2descriptionextended", self.random.choice(DESCRIPTIONS)),
+        ("e2disabled", 1 if self.random.random() < 0.05 else 0),
+        ("e2timebegin", start - 180),
+        ("e2timeend", start + duration + 300),
+        ("e2duration", duration + 480),
+        ("e2justplay", 0),
+        ("e2afterevent", 3),
+        ("e2location", DEFAULT_LOCATION),
+        ("e2tags", tags),
+        ("e2state", 0),
+        ("e2repeated", self.random.choice([31, 96, 127, 1]) if repeating else 0),
+        ("e2cancled", "False"),
+      ]))
+
+    self.write("web/timerlist", {}, XML_HEADER + "<e2timerlist>\n" + "".join(timers) + "</e2timerlist>\n")
+
+  def generate_autotimers(self, channels):
+    body = XML_HEADER + '<autotimer version="7">\n'
+    for i in range(self.args.autotimers):
+      title = self.random.choice(TITLES)
+      attributes = 'name="%s" match="%s" enabled="%s" id="%d" encoding="UTF-8" searchType="%s" searchCase="insensitive"' % (
+        escape(title), escape(title), "no" if self.random.random() < 0.1 else "yes", i + 1, self.random.choice(["exact", "partial", "description"]))
+      if self.random.random() < 0.5:
+        attributes += ' from="18:00" to="23:30"'
+      if self.random.random() < 0.5:
+        attributes += ' offset="3,5"'
+
+      body += "  <timer %s>\n" % attributes
+      if channels and self.random.random() < 0.7:
+        for reference, name in self.random.sample(channels, min(len(channels), self.random.randint(1, 3))):
+          body += "    <e2service>\n      <e2servicereference>%s</e2servicereference>\n      <e2servicename>%s</e2servicename>\n    </e2service>\n" % (escape(reference), escape(name))
+      body += "    <e2tags>%s</e2tags>\n  </timer>\n" % escape(title.replace(" ", "_"))
+
+    self.write("autotimer", {}, body + "</autotimer>\n")
+
+
+def xml_element(name, fields):
+  tag = name.split(" ")[0]
+  body = "".join("    <%s>%s</%s>\n" % (field, escape(str(value)), field.split(" ")[0]) for field, value in fields)
+  return "  <%s>\n%s  </%s>\n" % (name, body, tag)
+
+
+def service_list(services):
+  return XML_HEADER + "<e2servicelist>\n" + "".join(xml_element("e2service", [("e2servicereference", reference), ("e2servicename", name)]) for reference, name in services) + "</e2servicelist>\n"
+
+
+def main():
+  script_dir = os.path.dirname(os.path.abspath(__file__))
+
+  parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+  parser.add_argument("--out", required=True, help="output directory, existing files are overwritten")
+  parser.add_argument("--large", action="store_true", help="use the size of the largest known installations as defaults")
+  parser.add_argument("--channels", type=int, help="TV channels (default: %d, large: %d)" % (DEFAULT["channels"], LARGE["channels"]))
+  parser.add_argument("--radio-channels", type=int, help="radio channels (default: %d, large: %d)" % (DEFAULT["radio_channels"], LARGE["radio_channels"]))
+  parser.add_argument("--bouquets", type=int, help="TV bouquets (default: %d, large: %d)" % (DEFAULT["bouquets"], LARGE["bouquets"]))
+  parser.add_argument("--epg-days", type=int, help="days of EPG per channel (default: %d, large: %d)" % (DEFAULT["epg_days"], LARGE["epg_days"]))
+  parser.add_argument("--recordings", type=int, help="recordings (default: %d, large: %d)" % (DEFAULT["recordings"], LARGE["recordings"]))
+  parser.add_argument("--locations", type=int, help="recording locations (default: %d, large: %d)" % (DEFAULT["locations"], LARGE["locations"]))
+  parser.add_argument("--timers", type=int, help="timers (default: %d, large: %d)" % (DEFAULT["timers"], LARGE["timers"]))
+  parser.add_argument("--autotimers", type=int, help="auto timers (default: %d, large: %d)" % (DEFAULT["autotimers"], LARGE["autotimers"]))
+  parser.add_argument("--no-epgservice", action="store_true", help="skip the per channel web/epgservice files, which double the EPG size")
+  parser.add_argument("--start", type=int, help="unix time the EPG and timers are generated around (default: now)")
+  parser.add_argument("--seed", type=int, default=1)
+  parser.add_argument("--template", default=os.path.join(script_dir, "fixtures"), help="fixtures to copy the static responses from")
+  args = parser.parse_args()
+
+  for name, value in (LARGE if args.large else DEFAULT).items():
+    if getattr(args, name) is None:
+      setattr(args, name, value)
+
+  if args.bouquets < 1 or args.locations < 1:
+    parser.error("at least one bouquet and one location are required")
+
+  Generator(args).run()
+
+
+if __name__ == "__main__":
+  main()
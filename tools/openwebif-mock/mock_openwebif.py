@@ -0,0 +1,396 @@
+#!/usr/bin/env python3
+#
+#  Copyright (C) 2005-2021 Team Kodi (https://kodi.tv)
+#
+#  SPDX-License-Identifier: GPL-2.0-or-later
+#  See LICENSE.md for more information.
+#
+
+"""
+Stand-in OpenWebIf server for measuring the add-on against a fixed data set.
+
+The web port serves recorded responses from a fixture directory. A request is
+mapped to <fixtures>/<path>/<key>.xml (or .json for api/* calls) where the key
+is built from the parameters that identify the data (sRef, sref, bRef and
+dirname). If no file exists for the key <fixtures>/<path>/index.<ext> is used,
+so e.g. web/epgbouquet can have one file per bouquet while web/timerlist has a
+single one. Parameters such as time or endTime are ignored.
+
+Commands that change data on a real receiver (timeradd, moviedelete, ...) get a
+canned success response without changing the fixtures.
+
+The stream port serves an endless synthetic MPEG-TS stream (PAT, PMT and one
+H.264 video PID with PCR and random access markers) at a fixed bitrate for any
+path. Recordings are served from file?file=... as a finite stream of the
+same kind with range support, and <recording>.ap returns the matching access
+points.
+
+A summary of the requests per path is printed on exit.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import threading
+import time
+from collections import defaultdict
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, quote, urlsplit
+
+IDENTITY_PARAMS = ("sRef", "sref", "bRef", "dirname")
+
+SIMPLE_XML_COMMANDS = {
+  "web/timeradd",
+  "web/timerchange",
+  "web/timerdelete",
+  "web/timercleanup",
+  "web/moviedelete",
+  "web/moviemove",
+  "web/zap",
+  "web/powerstate",
+  "autotimer/edit",
+  "autotimer/remove",
+  "autotimer/set",
+}
+
+SIMPLE_JSON_COMMANDS = {
+  "api/saveconfig",
+}
+
+SIMPLE_XML_RESULT = (b'<?xml version="1.0" encoding="UTF-8"?>\n'
+                     b"<e2simplexmlresult>\n"
+                     b"  <e2state>True</e2state>\n"
+                     b"  <e2statetext>OK</e2statetext>\n"
+                     b"</e2simplexmlresult>\n")
+
+SIMPLE_JSON_RESULT = b'{"result": true, "message": ""}'
+
+
+def fixture_name(path, query):
+  """Returns the fixture file name relative to the fixture directory, shared with generate_fixtures.py"""
+  keys = []
+  for param in IDENTITY_PARAMS:
+    for value in query.get(param, []):
+      keys.append("%s=%s" % (param, quote(value, safe="")))
+
+  extension = ".json" if path.startswith("api/") else ".xml"
+  return os.path.join(path, ("&".join(keys) or "index") + extension)
+
+
+class TransportStream:
+  """Builds a minimal MPEG-TS stream the add-on can index: PAT, PMT and H.264 video with PCR"""
+
+  PACKET_SIZE = 188
+  PMT_PID = 0x1000
+  VIDEO_PID = 0x0100
+  FRAME_RATE = 25
+  GOP_LENGTH = 12
+  PCR_CLOCK = 90000
+
+  def __init__(self, bitrate):
+    self.frame_size = max(self.PACKET_SIZE, bitrate // 8 // self.FRAME_RATE)
+    self.continuity = defaultdict(int)
+    self.frame = 0
+
+  def next_gop(self):
+    """Returns the packets of the next group of pictures and the offsets of its keyframe within them"""
+    data = bytearray()
+    data += self.psi_packet(0, self.pat_section())
+    data += self.psi_packet(self.PMT_PID, self.pmt_section())
+    keyframe_offset = len(data)
+    for i in range(self.GOP_LENGTH):
+      data += self.video_frame(keyframe=(i == 0))
+    pts = self.frame_pts(self.frame - self.GOP_LENGTH)
+    return bytes(data), keyframe_offset, pts
+
+  def frame_pts(self, frame):
+    # start the PTS a little after the PCR like an encoder would
+    return (self.PCR_CLOCK + frame * self.PCR_CLOCK // self.FRAME_RATE) & 0x1FFFFFFFF
+
+  def next_continuity(self, pid):
+    counter = self.continuity[pid]
+    self.continuity[pid] = (counter + 1) & 0x0F
+    return counter
+
+  def psi_packet(self, pid, section):
+    header = struct.pack(">BHB", 0x47, 0x4000 | pid, 0x10 | self.next_continuity(pid))
+    payload = b"\x00" + section
+    return header + payload + b"\xff" * (self.PACKET_SIZE - len(header) - len(payload))
+
+  @staticmethod
+  def section(table_id, table_id_extension, body):
+    length = 5 + len(body) + 4
+    data = struct.pack(">BHHBBB", table_id, 0xB000 | length, table_id_extension, 0xC1, 0, 0) + body
+    return data + struct.pack(">I", crc32_mpeg(data))
+
+  def pat_section(self):
+    return self.section(0x00, 1, struct.pack(">HH", 1, 0xE000 | self.PMT_PID))
+
+  def pmt_section(self):
+    body = struct.pack(">HH", 0xE000 | self.VIDEO_PID, 0xF000)
+    body += struct.pack(">BHH", 0x1B, 0xE000 | self.VIDEO_PID, 0xF000)
+    return self.section(0x02, 1, body)
+
+  def video_frame(self, keyframe):
+    pts = self.frame_pts(self.frame)
+    pcr = (self.frame * self.PCR_CLOCK // self.FRAME_RATE) & 0x1FFFFFFFF
+    self.frame += 1
+
+    # access unit delimiter, then SPS, PPS and an IDR slice for keyframes or a non-IDR slice otherwise
+    es = b"\x00\x00\x00\x01\x09\xf0"
+    if keyframe:
+      es += b"\x00\x00\x00\x01\x67\x64\x00\x28" + b"\x00\x00\x00\x01\x68\xee\x3c\x80" + b"\x00\x00\x00\x01\x65\x88"
+    else:
+      es += b"\x00\x00\x00\x01\x41\x9a"
+
+    pes_header = b"\x00\x00\x01\xe0\x00\x00\x80\x80\x05" + encode_timestamp(0x21, pts)
+    payload = pes_header + es
+    payload += b"\x00" * max(0, self.frame_size - len(payload))
+
+    packets = bytearray()
+    first = True
+    while payload:
+      # the first packet of a frame carries the PCR and marks keyframes as random access points
+      adaptation = None
+      if first:
+        adaptation = bytes([0x10 | (0x40 if keyframe else 0)]) + encode_pcr(pcr)
+
+      space = self.PACKET_SIZE - 4 - (1 + len(adaptation) if adaptation is not None else 0)
+      if len(payload) < space:
+        # fill up the last packet of the frame with adaptation field stuffing
+        stuffing = self.PACKET_SIZE - 4 - 1 - len(payload)
+        if adaptation is None:
+          adaptation = b"\x00" + b"\xff" * (stuffing - 1) if stuffing > 0 else b""
+        else:
+          adaptation += b"\xff" * (stuffing - len(adaptation))
+        space = len(payload)
+
+      chunk = payload[:space]
+      payload = payload[space:]
+
+      control = (0x30 if adaptation is not None else 0x10) | self.next_continuity(self.VIDEO_PID)
+      header = struct.pack(">BHB", 0x47, (0x4000 if first else 0) | self.VIDEO_PID, control)
+      if adaptation is not None:
+        header += bytes([len(adaptation)]) + adaptation
+      packets += header + chunk
+      first = False
+
+    return bytes(packets)
+
+
+def encode_timestamp(marker, value):
+  return bytes([
+    marker | ((value >> 29) & 0x0E) | 0x01,
+    (value >> 22) & 0xFF,
+    ((value >> 14) & 0xFE) | 0x01,
+    (value >> 7) & 0xFF,
+    ((value << 1) & 0xFE) | 0x01,
+  ])
+
+
+def encode_pcr(base):
+  return struct.pack(">IH", (base >> 1) & 0xFFFFFFFF, ((base & 0x01) << 15) | 0x7E00)
+
+
+def crc32_mpeg(data):
+  crc = 0xFFFFFFFF
+  for byte in data:
+    crc ^= byte << 24
+    for _ in range(8):
+      crc = ((crc << 1) ^ 0x04C11DB7) if crc & 0x80000000 else (crc << 1)
+      crc &= 0xFFFFFFFF
+  return crc
+
+
+class Recording:
+  """A finite stream for file?file=... requests along with its Enigma2 access points file"""
+
+  def __init__(self, bitrate, seconds):
+    stream = TransportStream(bitrate)
+    data = bytearray()
+    access_points = bytearray()
+    while stream.frame < seconds * stream.FRAME_RATE:
+      gop, keyframe_offset, pts = stream.next_gop()
+      access_points += struct.pack(">QQ", len(data) + keyframe_offset, pts)
+      data += gop
+    self.data = bytes(data)
+    self.access_points = bytes(access_points)
+
+
+class Stats:
+  def __init__(self):
+    self.lock = threading.Lock()
+    self.entries = defaultdict(lambda: [0, 0, 0.0])
+
+  def add(self, path, size, seconds):
+    with self.lock:
+      entry = self.entries[path]
+      entry[0] += 1
+      entry[1] += size
+      entry[2] += seconds
+
+  def report(self, out=sys.stderr):
+    with self.lock:
+      out.write("%-32s %8s %12s %10s\n" % ("path", "requests", "bytes", "avg ms"))
+      for path, (count, size, seconds) in sorted(self.entries.items()):
+        out.write("%-32s %8d %12d %10.2f\n" % (path, count, size, seconds * 1000 / count))
+
+
+class WebHandler(BaseHTTPRequestHandler):
+  protocol_version = "HTTP/1.1"
+
+  def do_GET(self):
+    started = time.monotonic()
+    url = urlsplit(self.path)
+    path = url.path.strip("/")
+    query = parse_qs(url.query, keep_blank_values=True)
+
+    if self.server.latency:
+      time.sleep(self.server.latency)
+
+    if path == "file":
+      size = self.send_recording(query)
+    elif path in SIMPLE_XML_COMMANDS:
+      size = self.send_body(200, SIMPLE_XML_RESULT, "text/xml")
+    elif path in SIMPLE_JSON_COMMANDS:
+      size = self.send_body(200, SIMPLE_JSON_RESULT, "application/json")
+    else:
+      size = self.send_fixture(path, query)
+
+    self.server.stats.add(path, size, time.monotonic() - started)
+
+  def send_fixture(self, path, query):
+    for name in (fixture_name(path, query), fixture_name(path, {})):
+      file_path = os.path.join(self.server.fixtures, name)
+      if os.path.isfile(file_path):
+        with open(file_path, "rb") as f:
+          body = f.read()
+        return self.send_body(200, body, "application/json" if name.endswith(".json") else "text/xml")
+
+    if self.server.verbose:
+      sys.stderr.write("no fixture for %s\n" % fixture_name(path, query))
+    return self.send_body(404, b"", "text/plain")
+
+  def send_recording(self, query):
+    file = query.get("file", [""])[0]
+    if file.endswith(".ap"):
+      return self.send_body(200, self.server.recording.access_points, "application/octet-stream")
+
+    data = self.server.recording.data
+    start, end = 0, len(data) - 1
+    header = self.headers.get("Range", "")
+    if header.startswith("bytes="):
+      first, _, last = header[6:].partition("-")
+      start = int(first) if first else 0
+      end = min(int(last), end) if last else end
+      if start > end:
+        self.send_response(416)
+        self.send_header("Content-Range", "bytes */%d" % len(data))
+        self.send_header("Content-Length", "0")
+        self.end_headers()
+        return 0
+
+    body = data[start:end + 1]
+    self.send_response(206 if header else 200)
+    self.send_header("Content-Type", "video/mp2t")
+    self.send_header("Accept-Ranges", "bytes")
+    self.send_header("Content-Length", str(len(body)))
+    if header:
+      self.send_header("Content-Range", "bytes %d-%d/%d" % (start, end, len(data)))
+    self.end_headers()
+    self.wfile.write(body)
+    return len(body)
+
+  def send_body(self, status, body, content_type):
+    self.send_response(status)
+    self.send_header("Content-Type", content_type)
+    self.send_header("Content-Length", str(len(body)))
+    self.end_headers()
+    self.wfile.write(body)
+    return len(body)
+
+  def log_message(self, format, *args):
+    if self.server.verbose:
+      super().log_message(format, *args)
+
+
+class StreamHandler(BaseHTTPRequestHandler):
+  protocol_version = "HTTP/1.0"
+
+  def do_GET(self):
+    started = time.monotonic()
+    stream = TransportStream(self.server.bitrate)
+    bytes_per_second = self.server.bitrate / 8
+
+    self.send_response(200)
+    self.send_header("Content-Type", "video/mp2t")
+    self.end_headers()
+
+    sent = 0
+    try:
+      while True:
+        gop, _, _ = stream.next_gop()
+        self.wfile.write(gop)
+        sent += len(gop)
+
+        # keep to the bitrate so the stream behaves like a live channel
+        ahead = sent / bytes_per_second - (time.monotonic() - started)
+        if ahead > 0:
+          time.sleep(ahead)
+    except (BrokenPipeError, ConnectionResetError):
+      pass
+
+    self.server.stats.add("stream", sent, time.monotonic() - started)
+
+  def log_message(self, format, *args):
+    if self.server.verbose:
+      super().log_message(format, *args)
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+  parser.add_argument("--fixtures", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "fixtures"),
+                      help="fixture directory (default: %(default)s)")
+  parser.add_argument("--host", default="127.0.0.1")
+  parser.add_argument("--web-port", type=int, default=8080)
+  parser.add_argument("--stream-port", type=int, default=8001)
+  parser.add_argument("--latency-ms", type=float, default=0, help="delay added to each web request")
+  parser.add_argument("--bitrate", type=int, default=8000000, help="bitrate of the synthetic streams in bit/s")
+  parser.add_argument("--recording-secs", type=int, default=60, help="length of the recording served by file?file=...")
+  parser.add_argument("--verbose", action="store_true", help="log each request and missing fixtures")
+  args = parser.parse_args()
+
+  stats = Stats()
+
+  web = ThreadingHTTPServer((args.host, args.web_port), WebHandler)
+  web.fixtures = args.fixtures
+  web.latency = args.latency_ms / 1000
+  web.recording = Recording(args.bitrate, args.recording_secs)
+  web.verbose = args.verbose
+  web.stats = stats
+
+  stream = ThreadingHTTPServer((args.host, args.stream_port), StreamHandler)
+  stream.bitrate = args.bitrate
+  stream.verbose = args.verbose
+  stream.stats = stats
+
+  for server in (web, stream):
+    server.daemon_threads = True
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+
+  sys.stderr.write("Serving %s on http://%s:%d, streams on port %d\n" % (args.fixtures, args.host, args.web_port, args.stream_port))
+
+  try:
+    while True:
+      time.sleep(1)
+  except KeyboardInterrupt:
+    pass
+
+  web.shutdown()
+  stream.shutdown()
+  stats.report()
+
+
+if __name__ == "__main__":
+  main()